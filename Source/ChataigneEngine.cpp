@@ -15,7 +15,9 @@ ControllableContainer* getAppSettings();
 
 ChataigneEngine::ChataigneEngine() :
 	Engine("Chataigne", ".noisette"),
-	defaultBehaviors("Default Behaviors")
+	defaultBehaviors("Default Behaviors"),
+	snapshotSettings("Snapshots"),
+	lastSnapshotTime(0)
 	//ossiaDevice(nullptr)
 {
 
@@ -69,6 +71,14 @@ ChataigneEngine::ChataigneEngine() :
 
 
 	getAppSettings()->addChildControllableContainer(&defaultBehaviors);
+
+	autoSnapshot = snapshotSettings.addBoolParameter("Auto Snapshot", "If checked, a binary snapshot of the project is regularly written next to the saved file when something changed. It can be recovered with File > Recover from Snapshot", false);
+	autoSnapshotInterval = snapshotSettings.addIntParameter("Auto Snapshot Interval", "Minimum time between two automatic snapshots, in seconds", 60, 5, 3600);
+	getAppSettings()->addChildControllableContainer(&snapshotSettings);
+
+	snapshotWriter.reset(new ProjectSnapshotWriter());
+	snapshotWriter->onAutoSnapshot = [this]() { autoSaveSnapshot(); };
+	for (auto& m : getSnapshotManagers()) markSnapshotDirty(m);
 }
 
 ChataigneEngine::~ChataigneEngine()
@@ -78,6 +88,8 @@ ChataigneEngine::~ChataigneEngine()
 
 	isClearing = true;
 
+	snapshotWriter.reset();
+
 #if JUCE_WINDOWS
 	WindowsHooker::deleteInstance();
 #endif
@@ -106,6 +118,10 @@ ChataigneEngine::~ChataigneEngine()
 
 	CVGroupManager::deleteInstance();
 
+	ConditionValidationScheduler::deleteInstance();
+	MappingSampleCacheBaker::deleteInstance();
+	ParameterPublisher::deleteInstance();
+
 	Guider::deleteInstance();
 
 }
@@ -120,6 +136,8 @@ void ChataigneEngine::clearInternal()
 	ModuleRouterManager::getInstance()->clear();
 	ModuleManager::getInstance()->clear();
 	CVGroupManager::getInstance()->clear();
+
+	for (auto& m : getSnapshotManagers()) markSnapshotDirty(m);
 }
 
 var ChataigneEngine::getJSONData()
@@ -152,43 +170,59 @@ void ChataigneEngine::loadJSONDataInternalEngine(var data, ProgressTask* loading
 	ProgressTask* sequenceTask = loadingTask->addTask("Sequences");
 	ProgressTask* routerTask = loadingTask->addTask("Router");
 
-	ModuleManager::getInstance()->factory->updateCustomModules(false);
+	StringArray stageReport;
+	double loadStartMillis = Time::getMillisecondCounterHiRes();
 
-	moduleTask->start();
-	ModuleManager::getInstance()->loadJSONData(data.getProperty(ModuleManager::getInstance()->shortName, var()));
-	moduleTask->setProgress(1);
-	moduleTask->end();
-
-	cvTask->start();
-	CVGroupManager::getInstance()->loadJSONData(data.getProperty(CVGroupManager::getInstance()->shortName, var()));
-	cvTask->setProgress(1);
-	cvTask->end();
-
-	stateTask->start();
-	StateManager::getInstance()->loadJSONData(data.getProperty(StateManager::getInstance()->shortName, var()));
-	stateTask->setProgress(1);
-	stateTask->end();
+	auto loadStage = [&stageReport](ProgressTask* task, ControllableContainer* manager, var managerData)
+	{
+		double startMillis = Time::getMillisecondCounterHiRes();
+		task->start();
+		manager->loadJSONData(managerData);
+		task->setProgress(1);
+		task->end();
+		stageReport.add(manager->niceName + " " + String(Time::getMillisecondCounterHiRes() - startMillis, 0) + "ms");
+	};
+
+	double scanStartMillis = Time::getMillisecondCounterHiRes();
+	ModuleManager::getInstance()->factory->updateCustomModules(false);
+	stageReport.add("Custom module scan " + String(Time::getMillisecondCounterHiRes() - scanStartMillis, 0) + "ms");
 
-	sequenceTask->start();
-	ChataigneSequenceManager::getInstance()->loadJSONData(data.getProperty(ChataigneSequenceManager::getInstance()->shortName, var()));
-	sequenceTask->setProgress(1);
-	sequenceTask->end();
+	//Each stage resolves references to the ones loaded before it (custom variables can target module values), so they stay in order
+	loadStage(moduleTask, ModuleManager::getInstance(), data.getProperty(ModuleManager::getInstance()->shortName, var()));
+	loadStage(cvTask, CVGroupManager::getInstance(), data.getProperty(CVGroupManager::getInstance()->shortName, var()));
+	loadStage(stateTask, StateManager::getInstance(), data.getProperty(StateManager::getInstance()->shortName, var()));
+	loadStage(sequenceTask, ChataigneSequenceManager::getInstance(), data.getProperty(ChataigneSequenceManager::getInstance()->shortName, var()));
+	loadStage(routerTask, ModuleRouterManager::getInstance(), data.getProperty(ModuleRouterManager::getInstance()->shortName, var()));
 
-	routerTask->start();
-	ModuleRouterManager::getInstance()->loadJSONData(data.getProperty(ModuleRouterManager::getInstance()->shortName, var()));
-	routerTask->setProgress(1);
-	routerTask->end();
+	//the snapshot cache holds the previous project
+	for (auto& m : getSnapshotManagers()) markSnapshotDirty(m);
 
+	LOG("Project loaded in " << String(Time::getMillisecondCounterHiRes() - loadStartMillis, 0) << "ms (" << stageReport.joinIntoString(", ") << ")");
 }
 
 void ChataigneEngine::childStructureChanged(ControllableContainer* cc)
 {
 	Engine::childStructureChanged(cc);
+	if (isClearing || isLoadingFile || !MessageManager::getInstance()->isThisTheMessageThread()) return;
+	markSnapshotDirty(cc);
 }
 
 void ChataigneEngine::controllableFeedbackUpdate(ControllableContainer* cc, Controllable* c)
 {
-	if (isClearing || isLoadingFile) return;
+	//only edits of saved state make a snapshot dirty, incoming values and feedback change all the time
+	if (isClearing || isLoadingFile || !MessageManager::getInstance()->isThisTheMessageThread()) return;
+	if (c == nullptr || !c->isSavable || c->isControllableFeedbackOnly || c->type == Controllable::TRIGGER) return;
+
+	for (ControllableContainer* pc = cc; pc != nullptr; pc = pc->parentContainer.get())
+	{
+		if (Module* m = dynamic_cast<Module*>(pc))
+		{
+			if (m->isControllableInValuesContainer(c)) return;
+			break;
+		}
+	}
+
+	markSnapshotDirty(cc);
 }
 
 void ChataigneEngine::handleAsyncUpdate()
@@ -245,6 +279,122 @@ void ChataigneEngine::exportSelection()
 	);
 }
 
+Array<ControllableContainer*> ChataigneEngine::getSnapshotManagers()
+{
+	return { ModuleManager::getInstance(), CVGroupManager::getInstance(), StateManager::getInstance(), ChataigneSequenceManager::getInstance(), ModuleRouterManager::getInstance() };
+}
+
+void ChataigneEngine::markSnapshotDirty(ControllableContainer* cc)
+{
+	ControllableContainer* manager = cc;
+	while (manager != nullptr && manager->parentContainer.get() != this) manager = manager->parentContainer.get();
+	if (manager == nullptr) return;
+
+	dirtySnapshotManagers.addIfNotAlreadyThere(manager);
+}
+
+void ChataigneEngine::saveSnapshot(File f)
+{
+	if (f == File())
+	{
+		File defaultFile = getFile().existsAsFile() ? getFile().withFileExtension(ProjectSnapshot::fileExtension) : File::getCurrentWorkingDirectory();
+		FileChooser* fc(new FileChooser("Save a snapshot", defaultFile, String("*") + ProjectSnapshot::fileExtension));
+		fc->launchAsync(FileBrowserComponent::FileChooserFlags::saveMode | FileBrowserComponent::FileChooserFlags::canSelectFiles, [this](const FileChooser& fc)
+			{
+				File f = fc.getResult();
+				delete& fc;
+				if (f == File()) return;
+				saveSnapshot(f);
+			}
+		);
+		return;
+	}
+
+	if (isClearing || isLoadingFile) return;
+
+	Array<ControllableContainer*> dirtyManagers;
+	dirtyManagers.swapWith(dirtySnapshotManagers);
+
+	//Only the data is collected here, encoding and writing happen on the writer thread.
+	//Managers that did not change since the last snapshot are written from the writer cache
+	Array<ProjectSnapshotWriter::PendingSection> sections;
+	sections.add({ ProjectSnapshot::engineSectionName, Engine::getJSONData() });
+	for (auto& m : getSnapshotManagers()) sections.add({ m->shortName, dirtyManagers.contains(m) ? m->getJSONData() : var() });
+
+	lastSnapshotTime = Time::getMillisecondCounterHiRes();
+	snapshotWriter->save(f, sections);
+}
+
+void ChataigneEngine::autoSaveSnapshot()
+{
+	if (!autoSnapshot->boolValue() || !getFile().existsAsFile()) return;
+	if (Time::getMillisecondCounterHiRes() - lastSnapshotTime < autoSnapshotInterval->intValue() * 1000.0) return;
+
+	if (dirtySnapshotManagers.isEmpty()) return;
+
+	saveSnapshot(getFile().withFileExtension(ProjectSnapshot::fileExtension));
+}
+
+void ChataigneEngine::recoverFromSnapshot(File f)
+{
+	if (!f.existsAsFile())
+	{
+		FileChooser* fc(new FileChooser("Recover from a snapshot", getFile().existsAsFile() ? getFile().getParentDirectory() : File::getCurrentWorkingDirectory(), String("*") + ProjectSnapshot::fileExtension));
+		fc->launchAsync(FileBrowserComponent::FileChooserFlags::openMode | FileBrowserComponent::FileChooserFlags::canSelectFiles, [this](const FileChooser& fc)
+			{
+				File f = fc.getResult();
+				delete& fc;
+				if (f == File()) return;
+				recoverFromSnapshot(f);
+			}
+		);
+		return;
+	}
+
+	saveIfNeededAndUserAgreesAsync([this, f](FileBasedDocument::SaveResult result)
+		{
+			if (result == FileBasedDocument::userCancelledSave) return;
+
+			//recovered as a new noisette, so the original project file is never overwritten
+			File jsonFile = f.getSiblingFile(f.getFileNameWithoutExtension() + "_recovered.noisette").getNonexistentSibling();
+			if (!ProjectSnapshot::convertToJSON(f, jsonFile))
+			{
+				LOGERROR("Could not recover from " << f.getFileName());
+				return;
+			}
+
+			LOG("Recovered " << f.getFileName() << " to " << jsonFile.getFileName());
+			loadFrom(jsonFile, true);
+		});
+}
+
+void ChataigneEngine::convertToSnapshot(File f)
+{
+	if (!f.existsAsFile())
+	{
+		FileChooser* fc(new FileChooser("Convert a noisette to a snapshot", getFile().existsAsFile() ? getFile().getParentDirectory() : File::getCurrentWorkingDirectory(), "*.noisette"));
+		fc->launchAsync(FileBrowserComponent::FileChooserFlags::openMode | FileBrowserComponent::FileChooserFlags::canSelectFiles, [this](const FileChooser& fc)
+			{
+				File f = fc.getResult();
+				delete& fc;
+				if (f == File()) return;
+				convertToSnapshot(f);
+			}
+		);
+		return;
+	}
+
+	//written next to the noisette, an existing snapshot of it is kept
+	File snapshotFile = f.withFileExtension(ProjectSnapshot::fileExtension).getNonexistentSibling();
+	if (!ProjectSnapshot::convertFromJSON(f, snapshotFile))
+	{
+		LOGERROR("Could not convert " << f.getFileName() << " to a snapshot");
+		return;
+	}
+
+	LOG("Converted " << f.getFileName() << " to " << snapshotFile.getFileName() << " (" << File::descriptionOfSizeInBytes(f.getSize()) << " to " << File::descriptionOfSizeInBytes(snapshotFile.getSize()) << ")");
+}
+
 String ChataigneEngine::getMinimumRequiredFileVersion()
 {
 	return "1.6.12b5";
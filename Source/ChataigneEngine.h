@@ -12,6 +12,7 @@
 #pragma once
 class ChataigneGenericModule;
 class MultiplexModule;
+class ProjectSnapshotWriter;
 
 class ChataigneEngine :
 	public Engine
@@ -25,6 +26,13 @@ public:
 
 	//Global Settings
 	ControllableContainer defaultBehaviors;
+	ControllableContainer snapshotSettings;
+	BoolParameter* autoSnapshot;
+	IntParameter* autoSnapshotInterval;
+
+	std::unique_ptr<ProjectSnapshotWriter> snapshotWriter;
+	Array<ControllableContainer*> dirtySnapshotManagers; //message thread only
+	double lastSnapshotTime;
 
 	
 	void clearInternal() override;
@@ -39,6 +47,13 @@ public:
 
 	void importSelection(File f = File());
 	void exportSelection();
+
+	Array<ControllableContainer*> getSnapshotManagers();
+	void markSnapshotDirty(ControllableContainer* cc);
+	void saveSnapshot(File f = File());
+	void autoSaveSnapshot();
+	void recoverFromSnapshot(File f = File());
+	void convertToSnapshot(File f = File());
 		
 	String getMinimumRequiredFileVersion() override;
 
@@ -20,6 +20,8 @@
 #include "DMX/device/DMXEnttecProDevice.cpp"
 #include "DMX/device/DMXOpenUSBDevice.cpp"
 #include "DMX/device/DMXSACNDevice.cpp"
+#include "DMX/recording/DMXRecorder.cpp"
+#include "DMX/recording/DMXReplayer.cpp"
 
 #include "DMX/ui/DMXUniverseEditor.cpp"
 
@@ -36,6 +38,9 @@
 #include "Serial/SerialManager.cpp"
 #include "Serial/lib/cobs/cobs.cpp"
 #include "Zeroconf/ZeroconfManager.cpp" 
+#include "ParameterPublisher/ParameterPublisher.cpp"
+#include "Snapshot/ProjectSnapshot.cpp"
+#include "Snapshot/ProjectSnapshotWriter.cpp"
 
 #include "LTC/ltc.c"
 #include "LTC/timecode.c"
@@ -40,6 +40,8 @@ using namespace SimpleBLE;
 #include "DMX/device/DMXEnttecProDevice.h"
 #include "DMX/device/DMXOpenUSBDevice.h"
 #include "DMX/device/DMXSACNDevice.h"
+#include "DMX/recording/DMXRecorder.h"
+#include "DMX/recording/DMXReplayer.h"
 
 #include "DMX/ui/DMXUniverseEditor.h"
 
@@ -59,6 +61,11 @@ using namespace SimpleBLE;
 
 #include "Zeroconf/ZeroconfManager.h"
 
+#include "ParameterPublisher/ParameterPublisher.h"
+
+#include "Snapshot/ProjectSnapshot.h"
+#include "Snapshot/ProjectSnapshotWriter.h"
+
 #include "InputSystem/InputSystemManager.h"
 #include "InputSystem/InputDeviceHelpers.h"
 
@@ -12,9 +12,15 @@
 
 DMXSACNDevice::DMXSACNDevice() :
 	DMXDevice("SACN", SACN, true),
-	Thread("sACN Receive")
+	Thread("sACN Receive"),
+	currentMergeMode(HIGHEST_PRIORITY),
+	senderNeedsSetup(true),
+	hasUnicastDest(false),
+	lastDiscoveryTime(0)
 {
 	localPort = inputCC->addIntParameter("Local Port", "Local port to receive SACN data. This needs to be enabled in order to receive data", 5568, 0, 65535);
+	mergeMode = inputCC->addEnumParameter("Merge Mode", "How to combine several sources sending the same universe.\nHighest Priority only keeps the sources with the highest priority, and merges them in HTP if they share it.\nHTP merges all sources, regardless of their priority");
+	mergeMode->addOption("Highest Priority", HIGHEST_PRIORITY)->addOption("HTP", HTP);
 	//receiveMulticast = inputCC->addBoolParameter("Multicast", "If checked, this will receive in Multicast Mode", false);
 	//inputUniverse = inputCC->addIntParameter("Universe", "The Universe to receive from, from 0 to 15", 1, 1, 64000);
 	inputCC->editorIsCollapsed = true;
@@ -26,6 +32,7 @@ DMXSACNDevice::DMXSACNDevice() :
 	remotePort = outputCC->addIntParameter("Remote Port", "Local port to receive SACN data", 5568, 0, 65535);
 	//outputUniverse = outputCC->addIntParameter("Universe", "The Universe to send to, from 0 to 15", 1, 1, 64000);
 	priority = outputCC->addIntParameter("Priority", "Priority of the packets to send", 100, 0, 200);
+	keepAliveRate = outputCC->addFloatParameter("Keep Alive Rate", "Rate (in Hz) at which universes that did not change are resent. 0 will send unchanged universes at the full send rate", 1, 0, 44);
 	//setupSender();
 }
 
@@ -36,6 +43,9 @@ DMXSACNDevice::~DMXSACNDevice()
 	signalThreadShouldExit();
 	if (receiver != nullptr) receiver->shutdown();
 	stopThread(500);
+
+	GenericScopedLock lock(dmxLock);
+	sendStreamTerminated();
 }
 
 void DMXSACNDevice::setupReceiver()
@@ -60,7 +70,7 @@ void DMXSACNDevice::setupReceiver()
 	{
 		receiver->setEnablePortReuse(false);
 
-		for (auto& i : multicastIn) sender.joinMulticast(i);
+		for (auto& i : multicastIn) receiver->joinMulticast(i);
 
 		clearWarning();
 
@@ -79,12 +89,48 @@ void DMXSACNDevice::setupReceiver()
 
 void DMXSACNDevice::setupSender()
 {
-	if (isCurrentlyLoadingData) return;
-	if (!outputCC->enabled->boolValue()) return;
+	GenericScopedLock lock(dmxLock);
+	if (!outputCC->enabled->boolValue()) sendStreamTerminated();
+	senderNeedsSetup = true;
+}
+
+void DMXSACNDevice::rebuildSender()
+{
+	universesOut.clear();
+	universeOutMap.clear();
+	lastDiscoveryTime = 0;
+
+	hasUnicastDest = e131_unicast_dest(&unicastDest, remoteHost->stringValue().toRawUTF8(), (uint16_t)remotePort->intValue()) == 0;
+	if (!hasUnicastDest && multicastOutUniverses.isEmpty()) NLOGWARNING(niceName, "Could not resolve remote host " << remoteHost->stringValue());
+
+	senderNeedsSetup = false;
+}
+
+DMXSACNDevice::UniverseOut* DMXSACNDevice::getUniverseOut(int universe)
+{
+	if (UniverseOut* u = universeOutMap[universe]) return u;
+
+	UniverseOut* u = new UniverseOut();
+	u->universe = universe;
+
+	bool multicast = multicastOutUniverses.contains(universe);
+	if (e131_pkt_init(&u->packet, (uint16_t)universe, DMX_NUM_CHANNELS) != 0
+		|| (multicast && e131_multicast_dest(&u->dest, (uint16_t)universe, (uint16_t)remotePort->intValue()) != 0)
+		|| (!multicast && !hasUnicastDest))
+	{
+		delete u;
+		return nullptr;
+	}
+
+	if (!multicast) u->dest = unicastDest;
 
+	memcpy(u->packet.root.cid, senderCID.getRawData(), sizeof(u->packet.root.cid));
+	String name = nodeName->stringValue();
+	memcpy(u->packet.frame.source_name, name.toRawUTF8(), jmin<size_t>(name.getNumBytesAsUTF8(), sizeof(u->packet.frame.source_name) - 1));
 
-	e131_pkt_init(&senderPacket, 0, 512);
-	memcpy(&senderPacket.frame.source_name, nodeName->stringValue().getCharPointer(), nodeName->stringValue().length());
+	universesOut.add(u);
+	universeOutMap.set(universe, u);
+	return u;
 }
 
 void DMXSACNDevice::setupMulticast(Array<DMXUniverse*> in, Array<DMXUniverse*> out)
@@ -102,16 +148,11 @@ void DMXSACNDevice::setupMulticast(Array<DMXUniverse*> in, Array<DMXUniverse*> o
 	}
 
 
-	//Sender
-	for (auto& i : multicastIn) sender.leaveMulticast(i);
-
-	multicastOut.clear();
-	for (auto& u : out)
-	{
-		String s = getMulticastIPForUniverse(u->universe->intValue());
-		multicastOut.add(s);
-		sender.joinMulticast(s);
-	}
+	//Sender, multicast destinations are resolved in the prebuilt universe packets
+	GenericScopedLock lock(dmxLock);
+	multicastOutUniverses.clear();
+	for (auto& u : out) multicastOutUniverses.add(u->universe->intValue());
+	senderNeedsSetup = true;
 }
 
 //void DMXSACNDevice::sendDMXValue(int channel, int value)
@@ -136,21 +177,111 @@ void DMXSACNDevice::setupMulticast(Array<DMXUniverse*> in, Array<DMXUniverse*> o
 
 void DMXSACNDevice::sendDMXValuesInternal(int net, int subnet, int universe, uint8* values)
 {
-	//String ip = sendMulticast->boolValue() ? getMulticastIPForUniverse(outputUniverse->intValue()) : remoteHost->stringValue();
+	if (senderNeedsSetup) rebuildSender();
 
-	String ip = remoteHost->stringValue();
+	UniverseOut* u = getUniverseOut(universe);
+	if (u == nullptr) return;
 
-	senderPacket.frame.priority = priority->intValue();
-	senderPacket.frame.universe = universe;
-	memcpy(senderPacket.dmp.prop_val + 1, values, DMX_NUM_CHANNELS);
-	int numWritten = sender.write(ip, remotePort->intValue(), &senderPacket, sizeof(e131_packet_t));
+	uint32 now = Time::getMillisecondCounter();
+	uint8* slots = u->packet.dmp.prop_val + 1;
 
-	if (numWritten == -1)
+	//E1.31 6.6.1 : after a change, send a few identical packets before dropping to the keep-alive rate
+	if (memcmp(slots, values, DMX_NUM_CHANNELS) != 0)
+	{
+		memcpy(slots, values, DMX_NUM_CHANNELS);
+		u->numUnchangedSends = 0;
+	}
+	else
+	{
+		float rate = keepAliveRate->floatValue();
+		if (u->numUnchangedSends >= 3 && rate > 0 && now - u->lastSendTime < (uint32)(1000 / rate)) return;
+		u->numUnchangedSends++;
+	}
+
+	u->packet.frame.priority = (uint8)priority->intValue();
+
+	if (e131_send((int)sender.getRawSocketHandle(), &u->packet, &u->dest) < 0)
 	{
 		LOGWARNING("Error sending data");
 	}
 
-	senderPacket.frame.seq_number++;
+	u->packet.frame.seq_number++;
+	u->lastSendTime = now;
+
+	if (now - lastDiscoveryTime >= discoveryIntervalMs || lastDiscoveryTime == 0)
+	{
+		lastDiscoveryTime = now;
+		sendUniverseDiscovery();
+	}
+}
+
+void DMXSACNDevice::sendUniverseDiscovery()
+{
+	Array<int> universes;
+	for (auto& u : universesOut) universes.add(u->universe);
+	universes.sort();
+
+	String discoveryIP = getMulticastIPForUniverse(discoveryUniverse);
+	const uint8 acnPID[12] = { 0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00 };
+	String name = nodeName->stringValue();
+
+	const int universesPerPage = 512;
+	int lastPage = jmax(0, (universes.size() - 1) / universesPerPage);
+	uint8 buffer[120 + universesPerPage * 2];
+
+	for (int page = 0; page <= lastPage; page++)
+	{
+		int first = page * universesPerPage;
+		int count = jlimit(0, universesPerPage, universes.size() - first);
+		int total = 120 + count * 2;
+
+		int pos = 0;
+		auto put8 = [&](uint8 v) { buffer[pos++] = v; };
+		auto put16 = [&](int v) { put8((uint8)((v >> 8) & 0xFF)); put8((uint8)(v & 0xFF)); };
+		auto put32 = [&](uint32 v) { put16((int)(v >> 16)); put16((int)(v & 0xFFFF)); };
+
+		//Root layer
+		put16(0x0010);
+		put16(0x0000);
+		memcpy(buffer + pos, acnPID, 12); pos += 12;
+		put16(0x7000 | (total - 16));
+		put32(0x00000008); //VECTOR_ROOT_E131_EXTENDED
+		memcpy(buffer + pos, senderCID.getRawData(), 16); pos += 16;
+
+		//Framing layer
+		put16(0x7000 | (total - 38));
+		put32(0x00000002); //VECTOR_E131_EXTENDED_DISCOVERY
+		zeromem(buffer + pos, 64);
+		memcpy(buffer + pos, name.toRawUTF8(), jmin<size_t>(name.getNumBytesAsUTF8(), 63)); pos += 64;
+		put32(0);
+
+		//Universe discovery layer
+		put16(0x7000 | (total - 112));
+		put32(0x00000001); //VECTOR_UNIVERSE_DISCOVERY_UNIVERSE_LIST
+		put8((uint8)page);
+		put8((uint8)lastPage);
+		for (int i = 0; i < count; i++) put16(universes[first + i]);
+
+		sender.write(discoveryIP, remotePort->intValue(), buffer, total);
+	}
+}
+
+void DMXSACNDevice::sendStreamTerminated()
+{
+	//E1.31 6.2.6 : three packets with the terminated flag let receivers release the universe immediately
+	for (auto& u : universesOut)
+	{
+		e131_set_option(&u->packet, E131_OPT_TERMINATED, true);
+		for (int i = 0; i < 3; i++)
+		{
+			e131_send((int)sender.getRawSocketHandle(), &u->packet, &u->dest);
+			u->packet.frame.seq_number++;
+		}
+	}
+
+	universesOut.clear();
+	universeOutMap.clear();
+	senderNeedsSetup = true;
 }
 
 //void DMXSACNDevice::endLoadFile()
@@ -169,10 +300,11 @@ void DMXSACNDevice::onControllableFeedbackUpdate(ControllableContainer* cc, Cont
 {
 	DMXDevice::onControllableFeedbackUpdate(cc, c);
 	if (c == inputCC->enabled || c == localPort /*|| c == receiveMulticast || c == inputUniverse*/) setupReceiver();
+	else if (c == mergeMode) currentMergeMode = (int)mergeMode->getValueDataAsEnum<MergeMode>();
 	else if (cc == outputCC)
 	{
 		//if (c == sendMulticast) remoteHost->setEnabled(!sendMulticast->boolValue());
-		setupSender();
+		if (c != priority && c != keepAliveRate) setupSender(); //these are read on each send
 	}
 }
 
@@ -180,38 +312,138 @@ void DMXSACNDevice::run()
 {
 	if (!enabled) return;
 
+	universesIn.clear();
+	universeInMap.clear();
+
 	while (!threadShouldExit())
 	{
-		wait(10); //100fps
-
 		if (receiver == nullptr) return;
-		int numRead = receiver->read(&receivedPacket, sizeof(receivedPacket), true);
 
+		int ready = receiver->waitUntilReady(true, 100);
 		if (threadShouldExit()) return;
 
-		if (numRead == -1)
+		if (ready < 0)
 		{
 			LOGWARNING("Error receiving data");
+			wait(10);
 			continue;
 		}
 
-		if ((receivedError = e131_pkt_validate(&receivedPacket)) != E131_ERR_NONE) {
-			LOGWARNING("e131_pkt_validate: " << e131_strerror(receivedError));
-			continue;
+		//drain everything pending before merging, so a burst of universes costs a single pass
+		while (ready > 0 && !threadShouldExit())
+		{
+			int numRead = receiver->read(&receivedPacket, sizeof(receivedPacket), false);
+			if (numRead <= 0) break;
+			processReceivedPacket(numRead);
 		}
-		if (e131_pkt_discard(&receivedPacket, receivedSeq)) {
-			LOGWARNING("warning: packet out of order received\n");
-			continue;
+
+		removeExpiredSources(Time::getMillisecondCounter());
+
+		for (auto& u : universesIn)
+		{
+			if (!u->dirty) continue;
+			sendMergedUniverse(u);
+			u->dirty = false;
 		}
+	}
+}
+
+void DMXSACNDevice::processReceivedPacket(int numRead)
+{
+	if (numRead < (int)(sizeof(receivedPacket) - DMX_NUM_CHANNELS)) return;
+
+	if ((receivedError = e131_pkt_validate(&receivedPacket)) != E131_ERR_NONE)
+	{
+		LOGWARNING("e131_pkt_validate: " << e131_strerror(receivedError));
+		return;
+	}
+
+	if (e131_get_option(&receivedPacket, E131_OPT_PREVIEW)) return;
+	if (receivedPacket.dmp.prop_val[0] != 0) return; //only null start code carries levels
 
-		receivedSeq = receivedPacket.frame.seq_number;
+	int universe = ((receivedPacket.frame.universe >> 8) & 0xFF) | ((receivedPacket.frame.universe & 0xFF) << 8);
 
-		int universe = ((receivedPacket.frame.universe >> 8) & 0xFF) | ((receivedPacket.frame.universe & 0xFF) << 8);
-		//int numChannels = ((receivedPacket.dmp.prop_val_cnt >> 8) & 0xFF) | ((receivedPacket.dmp.prop_val_cnt & 0xFF) << 8);
-		//int firstChannel = ((receivedPacket.dmp.first_addr >> 8) & 0xFF) | ((receivedPacket.dmp.first_addr & 0xFF) << 8);
+	UniverseIn* u = universeInMap[universe];
+	if (u == nullptr)
+	{
+		u = universesIn.add(new UniverseIn());
+		u->universe = universe;
+		zeromem(u->merged, DMX_NUM_CHANNELS);
+		universeInMap.set(universe, u);
+	}
 
-		String sName((char*)receivedPacket.frame.source_name);
+	bool isNew = false;
+	SourceIn* s = getSourceIn(u, receivedPacket.root.cid);
+	if (s == nullptr)
+	{
+		s = u->sources.add(new SourceIn());
+		memcpy(s->cid, receivedPacket.root.cid, sizeof(s->cid));
+		isNew = true;
+	}
 
-		setDMXValuesIn(0, 0, universe, Array<uint8>(receivedPacket.dmp.prop_val + 1, DMX_NUM_CHANNELS));
+	if (e131_get_option(&receivedPacket, E131_OPT_TERMINATED))
+	{
+		u->sources.removeObject(s);
+		u->dirty = true;
+		return;
 	}
-}
\ No newline at end of file
+
+	if (!isNew && e131_pkt_discard(&receivedPacket, s->lastSeq)) return;
+
+	s->lastSeq = receivedPacket.frame.seq_number;
+	s->priority = jmin<uint8>(receivedPacket.frame.priority, 200);
+	s->lastReceived = Time::getMillisecondCounter();
+	if (isNew) s->name = String::fromUTF8((const char*)receivedPacket.frame.source_name, (int)strnlen((const char*)receivedPacket.frame.source_name, sizeof(receivedPacket.frame.source_name)));
+
+	int numSlots = jlimit(0, DMX_NUM_CHANNELS, (((receivedPacket.dmp.prop_val_cnt >> 8) & 0xFF) | ((receivedPacket.dmp.prop_val_cnt & 0xFF) << 8)) - 1);
+	numSlots = jmin(numSlots, numRead - (int)(sizeof(receivedPacket) - DMX_NUM_CHANNELS));
+	memcpy(s->values, receivedPacket.dmp.prop_val + 1, numSlots);
+	if (numSlots < DMX_NUM_CHANNELS) zeromem(s->values + numSlots, DMX_NUM_CHANNELS - numSlots);
+
+	u->dirty = true;
+}
+
+DMXSACNDevice::SourceIn* DMXSACNDevice::getSourceIn(UniverseIn* u, const uint8* cid)
+{
+	for (auto& s : u->sources) if (memcmp(s->cid, cid, sizeof(s->cid)) == 0) return s;
+	return nullptr;
+}
+
+void DMXSACNDevice::removeExpiredSources(uint32 now)
+{
+	for (auto& u : universesIn)
+	{
+		for (int i = u->sources.size() - 1; i >= 0; i--)
+		{
+			if (now - u->sources[i]->lastReceived < sourceTimeoutMs) continue;
+			u->sources.remove(i);
+			u->dirty = true;
+		}
+	}
+}
+
+void DMXSACNDevice::sendMergedUniverse(UniverseIn* u)
+{
+	if (u->sources.isEmpty()) return; //keep the last merged levels on data loss
+
+	uint8 minPriority = 0;
+	if (currentMergeMode == HIGHEST_PRIORITY)
+	{
+		for (auto& s : u->sources) minPriority = jmax(minPriority, s->priority);
+	}
+
+	bool first = true;
+	StringArray names;
+	for (auto& s : u->sources)
+	{
+		if (s->priority < minPriority) continue;
+
+		if (first) memcpy(u->merged, s->values, DMX_NUM_CHANNELS);
+		else for (int i = 0; i < DMX_NUM_CHANNELS; i++) u->merged[i] = jmax(u->merged[i], s->values[i]);
+
+		first = false;
+		names.add(s->name);
+	}
+
+	setDMXValuesIn(0, 0, u->universe, Array<uint8>(u->merged, DMX_NUM_CHANNELS), names.joinIntoString(", "));
+}
@@ -28,6 +28,8 @@ public:
 
 	//EnumParameter * networkInterface;
 	IntParameter* localPort;
+	enum MergeMode { HIGHEST_PRIORITY, HTP };
+	EnumParameter* mergeMode;
 	//BoolParameter* receiveMulticast;
 	//IntParameter* inputUniverse;
 
@@ -38,23 +40,71 @@ public:
 	//BoolParameter* sendMulticast;
 	//IntParameter* outputUniverse;
 	IntParameter* priority;
+	FloatParameter* keepAliveRate;
 
 	//Receiver
 	std::unique_ptr<DatagramSocket> receiver;
 	e131_packet_t receivedPacket;
 	e131_error_t receivedError;
-	uint8_t receivedSeq = 0x00;
+
+	//E1.31 sources are identified by their CID, sequence numbers are tracked per source and per universe
+	struct SourceIn
+	{
+		uint8 cid[16];
+		String name;
+		uint8 lastSeq = 0;
+		uint8 priority = 0;
+		uint32 lastReceived = 0;
+		uint8 values[DMX_NUM_CHANNELS];
+	};
+
+	struct UniverseIn
+	{
+		int universe = 0;
+		OwnedArray<SourceIn> sources;
+		bool dirty = false;
+		uint8 merged[DMX_NUM_CHANNELS];
+	};
+
+	OwnedArray<UniverseIn> universesIn; //receive thread only
+	HashMap<int, UniverseIn*> universeInMap;
+	std::atomic<int> currentMergeMode;
+
+	static const uint32 sourceTimeoutMs = 2500; //E1.31 network data loss timeout
 
 	//Sender
 	DatagramSocket sender;
-	e131_packet_t senderPacket;
-	e131_addr_t senderDest;
+	Uuid senderCID;
+
+	//one prebuilt packet and resolved destination per output universe, so a frame only copies levels and sends
+	struct UniverseOut
+	{
+		int universe = 0;
+		e131_packet_t packet;
+		e131_addr_t dest;
+		int numUnchangedSends = 0;
+		uint32 lastSendTime = 0;
+	};
+
+	OwnedArray<UniverseOut> universesOut; //guarded by dmxLock
+	HashMap<int, UniverseOut*> universeOutMap;
+	bool senderNeedsSetup;
+	bool hasUnicastDest;
+	e131_addr_t unicastDest;
+	uint32 lastDiscoveryTime;
+
+	static const int discoveryUniverse = 64214;
+	static const uint32 discoveryIntervalMs = 10000; //E1.31 universe discovery interval
 
 	Array<String> multicastIn;
-	Array<String> multicastOut;
+	Array<int> multicastOutUniverses;
 
 	void setupReceiver();
 	void setupSender();
+	void rebuildSender();
+	UniverseOut* getUniverseOut(int universe);
+	void sendUniverseDiscovery();
+	void sendStreamTerminated();
 
 	void setupMulticast(Array<DMXUniverse*> in, Array<DMXUniverse*> out) override;
 
@@ -70,5 +120,10 @@ public:
 
 	void onControllableFeedbackUpdate(ControllableContainer* cc, Controllable* c) override;
 
+	void processReceivedPacket(int numRead);
+	SourceIn* getSourceIn(UniverseIn* u, const uint8* cid);
+	void removeExpiredSources(uint32 now);
+	void sendMergedUniverse(UniverseIn* u);
+
 	void run() override;
 };
@@ -0,0 +1,175 @@
+/*
+  ==============================================================================
+
+	DMXRecorder.cpp
+	Created: 19 Oct 2026 2:01:21am
+	Author:  agent
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+
+DMXRecorder::DMXRecorder(File file) :
+	Thread("DMX Recorder"),
+	file(file),
+	fifo(fifoSize),
+	startTicks(Time::getHighResolutionTicks()),
+	numDroppedFrames(0),
+	nextCheckpointTime(0),
+	numRecords(0)
+{
+	frames.malloc(fifoSize);
+	startThread();
+}
+
+DMXRecorder::~DMXRecorder()
+{
+	stopThread(3000);
+}
+
+int64 DMXRecorder::getCurrentTime() const
+{
+	return (int64)(Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - startTicks) * 1000000.0);
+}
+
+void DMXRecorder::addFrame(int net, int subnet, int universe, const uint8* values)
+{
+	GenericScopedLock lock(writeLock);
+
+	int start1, size1, start2, size2;
+	fifo.prepareToWrite(1, start1, size1, start2, size2);
+	if (size1 == 0)
+	{
+		numDroppedFrames++;
+		return;
+	}
+
+	Frame& f = frames[start1];
+	f.time = getCurrentTime();
+	f.net = (uint8)net;
+	f.subnet = (uint8)subnet;
+	f.universe = (uint16)universe;
+	memcpy(f.values, values, DMX_NUM_CHANNELS);
+
+	fifo.finishedWrite(1);
+}
+
+void DMXRecorder::run()
+{
+	file.deleteFile();
+	FileOutputStream os(file, 1 << 20);
+	if (os.failedToOpen())
+	{
+		LOGERROR("Could not open " << file.getFullPathName() << " for DMX recording");
+		return;
+	}
+
+	os.write(DMXRecording::magic, 4);
+	os.writeShort((short)DMXRecording::version);
+	os.writeShort(0);
+	os.writeInt(DMXRecording::checkpointIntervalMs);
+
+	while (!threadShouldExit())
+	{
+		wait(20);
+		writePendingFrames(os);
+
+		int64 now = getCurrentTime();
+		if (now >= nextCheckpointTime) writeCheckpoint(os, now);
+	}
+
+	writePendingFrames(os);
+	os.flush();
+
+	NLOG("DMX Recorder", numRecords << " records written to " << file.getFileName() << " (" << File::descriptionOfSizeInBytes(file.getSize()) << ")");
+	if (numDroppedFrames > 0) LOGWARNING("DMX Recorder dropped " << numDroppedFrames.load() << " frames, the disk could not keep up");
+}
+
+void DMXRecorder::writePendingFrames(OutputStream& os)
+{
+	int start1, size1, start2, size2;
+	fifo.prepareToRead(fifo.getNumReady(), start1, size1, start2, size2);
+	for (int i = 0; i < size1; i++) writeFrame(os, frames[start1 + i]);
+	for (int i = 0; i < size2; i++) writeFrame(os, frames[start2 + i]);
+	fifo.finishedRead(size1 + size2);
+}
+
+void DMXRecorder::writeRecordHeader(OutputStream& os, int64 time, DMXRecording::RecordType type, int net, int subnet, int universe, int payloadSize)
+{
+	os.writeInt64(time);
+	os.writeByte((char)type);
+	os.writeByte((char)net);
+	os.writeByte((char)subnet);
+	os.writeShort((short)universe);
+	os.writeShort((short)payloadSize);
+	numRecords++;
+}
+
+void DMXRecorder::writeFrame(OutputStream& os, const Frame& f)
+{
+	int key = DMXRecording::getUniverseKey(f.net, f.subnet, f.universe);
+	UniverseState* u = universeMap[key];
+	if (u == nullptr)
+	{
+		u = universes.add(new UniverseState());
+		u->net = f.net;
+		u->subnet = f.subnet;
+		u->universe = f.universe;
+		memcpy(u->values, f.values, DMX_NUM_CHANNELS);
+		universeMap.set(key, u);
+
+		writeRecordHeader(os, f.time, DMXRecording::FULL, f.net, f.subnet, f.universe, DMX_NUM_CHANNELS);
+		os.write(f.values, DMX_NUM_CHANNELS);
+		return;
+	}
+
+	//runs of changed channels, small unchanged gaps are merged to avoid paying a run header for them
+	uint8 delta[DMX_NUM_CHANNELS * 3]; //stops growing once it is as big as a full frame
+	int deltaSize = 0;
+	int i = 0;
+	while (i < DMX_NUM_CHANNELS && deltaSize < DMX_NUM_CHANNELS)
+	{
+		if (f.values[i] == u->values[i])
+		{
+			i++;
+			continue;
+		}
+
+		int start = i;
+		int end = i + 1;
+		for (int j = i + 1; j < DMX_NUM_CHANNELS && j - end < 4; j++) if (f.values[j] != u->values[j]) end = j + 1;
+
+		int length = end - start;
+		ByteOrder::littleEndian16BitToChars((uint16)start, delta + deltaSize);
+		ByteOrder::littleEndian16BitToChars((uint16)length, delta + deltaSize + 2);
+		memcpy(delta + deltaSize + 4, f.values + start, length);
+		deltaSize += 4 + length;
+		i = end;
+	}
+
+	if (deltaSize >= DMX_NUM_CHANNELS)
+	{
+		writeRecordHeader(os, f.time, DMXRecording::FULL, f.net, f.subnet, f.universe, DMX_NUM_CHANNELS);
+		os.write(f.values, DMX_NUM_CHANNELS);
+	}
+	else
+	{
+		//an empty delta keeps the frame timing, so replays load the input path like the original show
+		writeRecordHeader(os, f.time, DMXRecording::DELTA, f.net, f.subnet, f.universe, deltaSize);
+		if (deltaSize > 0) os.write(delta, deltaSize);
+	}
+
+	memcpy(u->values, f.values, DMX_NUM_CHANNELS);
+}
+
+void DMXRecorder::writeCheckpoint(OutputStream& os, int64 time)
+{
+	for (auto& u : universes)
+	{
+		writeRecordHeader(os, time, DMXRecording::SYNC, u->net, u->subnet, u->universe, DMX_NUM_CHANNELS);
+		os.write(u->values, DMX_NUM_CHANNELS);
+	}
+
+	nextCheckpointTime = time + DMXRecording::checkpointIntervalMs * 1000;
+}
@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+	DMXRecorder.h
+	Created: 19 Oct 2026 2:01:21am
+	Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//Binary layout shared by the recorder and the replayer, all values little endian
+//File header : "CDMX", uint16 version, uint16 reserved, uint32 checkpoint interval (ms)
+//Record : int64 time (us), uint8 type, uint8 net, uint8 subnet, uint16 universe, uint16 payload size, payload
+//FULL and SYNC payloads are the 512 channels, DELTA payloads are runs of { uint16 start, uint16 length, values }
+namespace DMXRecording
+{
+	enum RecordType { FULL, DELTA, SYNC };
+
+	const char magic[4] = { 'C', 'D', 'M', 'X' };
+	const int version = 1;
+	const int fileHeaderSize = 12;
+	const int recordHeaderSize = 15;
+	const int checkpointIntervalMs = 1000;
+
+	inline int getUniverseKey(int net, int subnet, int universe) { return (net << 24) | (subnet << 16) | (universe & 0xFFFF); }
+}
+
+//Captures incoming universes from the receive threads into a bounded fifo,
+//and streams them to disk from its own thread with delta encoding and periodic full checkpoints for seeking
+class DMXRecorder :
+	public Thread
+{
+public:
+	DMXRecorder(File file);
+	~DMXRecorder();
+
+	File file;
+
+	struct Frame
+	{
+		int64 time;
+		uint8 net;
+		uint8 subnet;
+		uint16 universe;
+		uint8 values[DMX_NUM_CHANNELS];
+	};
+
+	static const int fifoSize = 4096; //about 2MB, so memory stays bounded whatever the show size
+
+	HeapBlock<Frame> frames;
+	AbstractFifo fifo;
+	SpinLock writeLock; //several devices or receive threads may push
+	int64 startTicks;
+	std::atomic<int> numDroppedFrames;
+
+	struct UniverseState
+	{
+		uint8 net;
+		uint8 subnet;
+		uint16 universe;
+		uint8 values[DMX_NUM_CHANNELS];
+	};
+
+	OwnedArray<UniverseState> universes; //recording thread only
+	HashMap<int, UniverseState*> universeMap;
+	int64 nextCheckpointTime;
+	int64 numRecords;
+
+	void addFrame(int net, int subnet, int universe, const uint8* values);
+	int64 getCurrentTime() const;
+
+	void run() override;
+
+private:
+	void writePendingFrames(OutputStream& os);
+	void writeFrame(OutputStream& os, const Frame& f);
+	void writeCheckpoint(OutputStream& os, int64 time);
+	void writeRecordHeader(OutputStream& os, int64 time, DMXRecording::RecordType type, int net, int subnet, int universe, int payloadSize);
+
+	JUCE_DECLARE_NON_COPYABLE(DMXRecorder)
+};
@@ -0,0 +1,213 @@
+/*
+  ==============================================================================
+
+	DMXReplayer.cpp
+	Created: 19 Oct 2026 2:01:21am
+	Author:  agent
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+
+DMXReplayer::DMXReplayer(File file, ReplayerListener* listener) :
+	Thread("DMX Replayer"),
+	file(file),
+	listener(listener),
+	data(nullptr),
+	dataSize(0),
+	duration(0),
+	seekTime(-1),
+	loop(false)
+{
+	mappedFile.reset(new MemoryMappedFile(file, MemoryMappedFile::readOnly, false));
+	if (mappedFile->getData() == nullptr)
+	{
+		LOGERROR("Could not open " << file.getFullPathName() << " for DMX replay");
+		return;
+	}
+
+	data = (const uint8*)mappedFile->getData();
+	dataSize = (int64)mappedFile->getSize();
+
+	startThread();
+}
+
+DMXReplayer::~DMXReplayer()
+{
+	stopThread(1000);
+}
+
+void DMXReplayer::seek(double time)
+{
+	seekTime = jmax(0.0, time);
+	notify();
+}
+
+bool DMXReplayer::readRecord(int64 offset, Record& r) const
+{
+	if (offset + DMXRecording::recordHeaderSize > dataSize) return false;
+
+	const uint8* h = data + offset;
+	r.time = (int64)ByteOrder::littleEndianInt64(h);
+	r.type = (DMXRecording::RecordType)h[8];
+	r.net = h[9];
+	r.subnet = h[10];
+	r.universe = ByteOrder::littleEndianShort(h + 11);
+	r.payloadSize = ByteOrder::littleEndianShort(h + 13);
+	r.payload = h + DMXRecording::recordHeaderSize;
+
+	return offset + DMXRecording::recordHeaderSize + r.payloadSize <= dataSize;
+}
+
+bool DMXReplayer::buildIndex()
+{
+	if (dataSize < DMXRecording::fileHeaderSize || memcmp(data, DMXRecording::magic, 4) != 0)
+	{
+		LOGERROR(file.getFileName() << " is not a DMX recording");
+		return false;
+	}
+
+	//only headers are touched, so even hour long recordings index quickly from the mapped view
+	Record r;
+	int64 offset = DMXRecording::fileHeaderSize;
+	bool lastWasSync = false;
+	int64 lastTime = 0;
+
+	while (readRecord(offset, r) && !threadShouldExit())
+	{
+		bool isSync = r.type == DMXRecording::SYNC;
+		if (isSync && !lastWasSync) checkpoints.add({ r.time, offset });
+		lastWasSync = isSync;
+		lastTime = r.time;
+		offset += DMXRecording::recordHeaderSize + r.payloadSize;
+	}
+
+	dataSize = offset; //ignore a truncated last record
+	duration = lastTime / 1000000.0;
+	return true;
+}
+
+DMXReplayer::UniverseState* DMXReplayer::applyRecord(const Record& r)
+{
+	int key = DMXRecording::getUniverseKey(r.net, r.subnet, r.universe);
+	UniverseState* u = universeMap[key];
+	if (u == nullptr)
+	{
+		u = universes.add(new UniverseState());
+		u->net = (uint8)r.net;
+		u->subnet = (uint8)r.subnet;
+		u->universe = (uint16)r.universe;
+		zeromem(u->values, DMX_NUM_CHANNELS);
+		universeMap.set(key, u);
+	}
+
+	if (r.type == DMXRecording::DELTA)
+	{
+		int pos = 0;
+		while (pos + 4 <= r.payloadSize)
+		{
+			int start = ByteOrder::littleEndianShort(r.payload + pos);
+			int length = ByteOrder::littleEndianShort(r.payload + pos + 2);
+			pos += 4;
+			if (start + length > DMX_NUM_CHANNELS || pos + length > r.payloadSize) break;
+			memcpy(u->values + start, r.payload + pos, length);
+			pos += length;
+		}
+	}
+	else
+	{
+		memcpy(u->values, r.payload, jmin(r.payloadSize, DMX_NUM_CHANNELS));
+	}
+
+	return u;
+}
+
+int64 DMXReplayer::seekInternal(int64 time)
+{
+	//start from the last checkpoint before the target, it holds the full state of every universe
+	int64 offset = DMXRecording::fileHeaderSize;
+	for (int i = checkpoints.size() - 1; i >= 0; i--)
+	{
+		if (checkpoints.getReference(i).time <= time)
+		{
+			offset = checkpoints.getReference(i).offset;
+			break;
+		}
+	}
+
+	Record r;
+	while (readRecord(offset, r) && r.time <= time)
+	{
+		applyRecord(r);
+		offset += DMXRecording::recordHeaderSize + r.payloadSize;
+	}
+
+	for (auto& u : universes) listener->replayFrame(u->net, u->subnet, u->universe, u->values);
+	return offset;
+}
+
+void DMXReplayer::waitUntil(double targetMillis)
+{
+	//coarse sleep, then yield for the last millisecond so frames keep their recorded spacing
+	while (!threadShouldExit() && seekTime < 0)
+	{
+		double remaining = targetMillis - Time::getMillisecondCounterHiRes();
+		if (remaining <= 0) return;
+		if (remaining > 2) wait((int)remaining - 1);
+		else Thread::yield();
+	}
+}
+
+void DMXReplayer::run()
+{
+	if (!buildIndex()) return;
+
+	int64 offset = DMXRecording::fileHeaderSize;
+	int64 originTime = 0;
+	double originMillis = Time::getMillisecondCounterHiRes();
+	double lastNotifyMillis = 0;
+
+	Record r;
+
+	while (!threadShouldExit())
+	{
+		double target = seekTime.exchange(-1);
+		if (target >= 0)
+		{
+			originTime = (int64)(target * 1000000.0);
+			offset = seekInternal(originTime);
+			originMillis = Time::getMillisecondCounterHiRes();
+		}
+
+		if (!readRecord(offset, r))
+		{
+			if (!loop)
+			{
+				listener->replayTimeChanged(duration);
+				listener->replayFinished();
+				return;
+			}
+
+			seekTime = 0;
+			continue;
+		}
+
+		waitUntil(originMillis + (r.time - originTime) / 1000.0);
+		if (threadShouldExit()) return;
+		if (seekTime >= 0) continue;
+
+		UniverseState* u = applyRecord(r);
+		offset += DMXRecording::recordHeaderSize + r.payloadSize;
+
+		//checkpoints only restore state on seek, the frames around them already carry the same values
+		if (r.type != DMXRecording::SYNC) listener->replayFrame(u->net, u->subnet, u->universe, u->values);
+
+		double now = Time::getMillisecondCounterHiRes();
+		if (now - lastNotifyMillis > 50)
+		{
+			lastNotifyMillis = now;
+			listener->replayTimeChanged(r.time / 1000000.0);
+		}
+	}
+}
@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+	DMXReplayer.h
+	Created: 19 Oct 2026 2:01:21am
+	Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//Plays a DMXRecorder file back from a memory mapped view, with the original frame timing.
+//Seeking restores all universes from the closest checkpoint, then plays on from there.
+class DMXReplayer :
+	public Thread
+{
+public:
+	class ReplayerListener
+	{
+	public:
+		virtual ~ReplayerListener() {}
+		virtual void replayFrame(int net, int subnet, int universe, const uint8* values) = 0;
+		virtual void replayTimeChanged(double /*time*/) {}
+		virtual void replayFinished() {}
+	};
+
+	DMXReplayer(File file, ReplayerListener* listener);
+	~DMXReplayer();
+
+	File file;
+	ReplayerListener* listener;
+
+	std::unique_ptr<MemoryMappedFile> mappedFile;
+	const uint8* data;
+	int64 dataSize;
+
+	struct Checkpoint
+	{
+		int64 time; //us
+		int64 offset;
+	};
+
+	Array<Checkpoint> checkpoints;
+	double duration; //seconds, valid once the thread has indexed the file
+
+	std::atomic<double> seekTime; //negative when no seek is pending
+	std::atomic<bool> loop;
+
+	struct UniverseState
+	{
+		uint8 net;
+		uint8 subnet;
+		uint16 universe;
+		uint8 values[DMX_NUM_CHANNELS];
+	};
+
+	OwnedArray<UniverseState> universes; //replay thread only
+	HashMap<int, UniverseState*> universeMap;
+
+	void seek(double time);
+
+	void run() override;
+
+private:
+	struct Record
+	{
+		int64 time;
+		DMXRecording::RecordType type;
+		int net;
+		int subnet;
+		int universe;
+		int payloadSize;
+		const uint8* payload;
+	};
+
+	bool readRecord(int64 offset, Record& r) const;
+	bool buildIndex();
+	UniverseState* applyRecord(const Record& r);
+	int64 seekInternal(int64 time);
+	void waitUntil(double targetMillis);
+
+	JUCE_DECLARE_NON_COPYABLE(DMXReplayer)
+};
@@ -23,15 +23,17 @@ InputSystemManager::InputSystemManager() :
 		return;
 	}
 
+	SDL_JoystickEventState(SDL_ENABLE);
+	SDL_GameControllerEventState(SDL_ENABLE);
+
 	checkDevices();
 
 	startThread();
-	startTimerHz(1);
 }
 
 InputSystemManager::~InputSystemManager()
 {
-	stopTimer();
+	cancelPendingUpdate();
 	stopThread(1000);
 	SDL_Quit();
 }
@@ -45,6 +47,9 @@ void InputSystemManager::checkDevices()
     int numDevices = SDL_NumJoysticks();
 	for (int i = 0; i < numDevices; ++i)
 	{
+		//only open devices that are not already opened, opening increments SDL's refcount
+		if (getGamepadForDevID(SDL_JoystickGetDeviceInstanceID(i)) != nullptr) continue;
+
 		if (SDL_IsGameController(i))
 		{
 			SDL_GameController* g = SDL_GameControllerOpen(i);
@@ -70,23 +75,29 @@ void InputSystemManager::checkDevices()
 	}
 
 	Array<Gamepad*> gamepadsToRemove;
-	for (auto& g : gamepads)
 	{
-		//check removed devices
-		if (g->joystick != nullptr)
-		{
-			if (!SDL_JoystickGetAttached(g->joystick)) gamepadsToRemove.add(g);
-		}
-		else
+		GenericScopedLock lock(gamepads.getLock());
+		for (auto& g : gamepads)
 		{
-			if (!SDL_GameControllerGetAttached(g->gamepad)) gamepadsToRemove.add(g);
+			//check removed devices
+			if (g->joystick != nullptr)
+			{
+				if (!SDL_JoystickGetAttached(g->joystick)) gamepadsToRemove.add(g);
+			}
+			else
+			{
+				if (!SDL_GameControllerGetAttached(g->gamepad)) gamepadsToRemove.add(g);
+			}
 		}
 	}
+
 	for (auto& g : gamepadsToRemove) removeGamepad(g);
 }
 
 Gamepad* InputSystemManager::addGamepad(Gamepad * g)
 {
+	GenericScopedLock lock(gamepads.getLock());
+
 	gamepads.add(g);
 	LOG("Gamepad added : " << g->getName());
 	inputListeners.call(&InputManagerListener::gamepadAdded, g);
@@ -96,6 +107,8 @@ Gamepad* InputSystemManager::addGamepad(Gamepad * g)
 
 void InputSystemManager::removeGamepad(Gamepad* g)
 {
+	GenericScopedLock lock(gamepads.getLock());
+
 	if (!gamepads.contains(g)) return;
 	gamepads.removeObject(g, false);
 	
@@ -103,7 +116,8 @@ void InputSystemManager::removeGamepad(Gamepad* g)
 	
 	inputListeners.call(&InputManagerListener::gamepadRemoved, g);
 	inputQueuedNotifier.addMessage(new InputSystemEvent(InputSystemEvent::GAMEPAD_REMOVED, g));
-	SDL_GameControllerClose(g->gamepad);
+	if (g->joystick != nullptr) SDL_JoystickClose(g->joystick);
+	else SDL_GameControllerClose(g->gamepad);
 	delete g;
 
 }
@@ -138,51 +152,92 @@ Gamepad* InputSystemManager::getGamepadForName(String name)
 	return nullptr;
 }
 
+Gamepad* InputSystemManager::getGamepadForDevID(SDL_JoystickID devID)
+{
+	for (auto& g : gamepads) if (g->getDevID() == devID) return g;
+	return nullptr;
+}
+
+void InputSystemManager::processEvent(const SDL_Event& e)
+{
+	switch (e.type)
+	{
+	//Hotplug : device indices and instances are resolved on the message thread, where listeners expect to be called
+	case SDL_JOYDEVICEADDED:
+	case SDL_JOYDEVICEREMOVED:
+	case SDL_CONTROLLERDEVICEADDED:
+	case SDL_CONTROLLERDEVICEREMOVED:
+		triggerAsyncUpdate();
+		break;
+
+	//Game controllers also emit raw joystick events, only take the ones matching the way the device was opened
+	case SDL_CONTROLLERAXISMOTION:
+		if (Gamepad* g = getGamepadForDevID(e.caxis.which)) if (g->gamepad != nullptr) g->setAxisValue(e.caxis.axis, e.caxis.value, e.caxis.timestamp);
+		break;
+
+	case SDL_CONTROLLERBUTTONDOWN:
+	case SDL_CONTROLLERBUTTONUP:
+		if (Gamepad* g = getGamepadForDevID(e.cbutton.which)) if (g->gamepad != nullptr) g->setButtonValue(e.cbutton.button, e.cbutton.state == SDL_PRESSED, e.cbutton.timestamp);
+		break;
+
+	case SDL_JOYAXISMOTION:
+		if (Gamepad* g = getGamepadForDevID(e.jaxis.which)) if (g->joystick != nullptr) g->setAxisValue(e.jaxis.axis, e.jaxis.value, e.jaxis.timestamp);
+		break;
+
+	case SDL_JOYBUTTONDOWN:
+	case SDL_JOYBUTTONUP:
+		if (Gamepad* g = getGamepadForDevID(e.jbutton.which)) if (g->joystick != nullptr) g->setButtonValue(e.jbutton.button, e.jbutton.state == SDL_PRESSED, e.jbutton.timestamp);
+		break;
+
+	default:
+		break;
+	}
+}
 
 void InputSystemManager::run()
 {
+	SDL_Event e;
+
 	while (!threadShouldExit())
 	{
-		wait(20); //50fps
-
-		if (Engine::mainEngine->isClearing || Engine::mainEngine->isLoadingFile) continue;
-        
-       // MessageManager::getInstance()->callFunctionOnMessageThread([](void *)->void*{SDL_Event e; SDL_PollEvent(&e); return nullptr;}, nullptr);
-        
-        int numDevices = SDL_NumJoysticks();
-        if(numDevices != gamepads.size())
-        {
-            DBG("Gamepad num change !");
-            continue;
-        }
-        SDL_JoystickUpdate();
-		SDL_GameControllerUpdate();
-
-		gamepads.getLock().enter();
-		for (auto& g : gamepads)
+		//Block until an event arrives, the timeout only bounds the time to stop the thread. Then drain what is queued.
+		if (!SDL_WaitEventTimeout(&e, 100)) continue;
+
+		do
 		{
-			if (g != nullptr) g->update();
-		}
-		gamepads.getLock().exit();
+			if (Engine::mainEngine->isClearing || Engine::mainEngine->isLoadingFile)
+			{
+				if (e.type == SDL_JOYDEVICEADDED || e.type == SDL_JOYDEVICEREMOVED) triggerAsyncUpdate();
+				continue;
+			}
+
+			GenericScopedLock lock(gamepads.getLock());
+			processEvent(e);
+		} while (SDL_PollEvent(&e));
 	}
 }
 
-void InputSystemManager::timerCallback()
+void InputSystemManager::handleAsyncUpdate()
 {
-    checkDevices();
+	checkDevices();
 }
 
 Gamepad::Gamepad(SDL_GameController* gamepad) :
 	gamepad(gamepad),
 	joystick(nullptr)
 {
-
+	axisValues.insertMultiple(0, 0, getNumAxes());
+	buttonValues.insertMultiple(0, false, getNumButtons());
+	update();
 }
 
 Gamepad::Gamepad(SDL_Joystick* joystick) :
 	gamepad(nullptr),
 	joystick(joystick)
 {
+	axisValues.insertMultiple(0, 0, getNumAxes());
+	buttonValues.insertMultiple(0, false, getNumButtons());
+	update();
 }
 
 Gamepad::~Gamepad()
@@ -192,25 +247,44 @@ Gamepad::~Gamepad()
 
 void Gamepad::update()
 {
-	int numAxes = joystick != nullptr ? SDL_JoystickNumAxes(joystick) : SDL_CONTROLLER_AXIS_MAX;
-	int numButtons = joystick != nullptr ? SDL_JoystickNumButtons(joystick) : SDL_CONTROLLER_BUTTON_MAX;
-
-	Array<float> axes;
-	Array<bool> buttons;
+	//Reads the whole state at once, used to sync after opening the device. Only changed values are dispatched.
+	uint32 timestamp = SDL_GetTicks();
 
-	for (int i = 0; i < numAxes; ++i)
+	for (int i = 0; i < axisValues.size(); ++i)
 	{
 		float val = joystick != nullptr ? (float)SDL_JoystickGetAxis(joystick, i) : (float)SDL_GameControllerGetAxis(gamepad, (SDL_GameControllerAxis)i);
-		axes.add(val);
+		setAxisValue(i, val, timestamp);
 	}
 
-	for (int i = 0; i < numButtons; ++i)
+	for (int i = 0; i < buttonValues.size(); ++i)
 	{
 		bool val = joystick != nullptr ? (SDL_JoystickGetButton(joystick, i) > 0) : (SDL_GameControllerGetButton(gamepad, (SDL_GameControllerButton)i) > 0);
-		buttons.add(val);
+		setButtonValue(i, val, timestamp);
 	}
+}
+
+void Gamepad::setAxisValue(int index, float value, uint32 timestamp)
+{
+	if (!isPositiveAndBelow(index, axisValues.size()) || axisValues[index] == value) return;
+	axisValues.set(index, value);
+	gamepadListeners.call(&GamepadListener::gamepadAxisChanged, this, index, value, timestamp);
+}
 
-	gamepadListeners.call(&GamepadListener::gamepadValuesUpdated, axes, buttons);
+void Gamepad::setButtonValue(int index, bool value, uint32 timestamp)
+{
+	if (!isPositiveAndBelow(index, buttonValues.size()) || buttonValues[index] == value) return;
+	buttonValues.set(index, value);
+	gamepadListeners.call(&GamepadListener::gamepadButtonChanged, this, index, value, timestamp);
+}
+
+int Gamepad::getNumAxes() const
+{
+	return joystick != nullptr ? SDL_JoystickNumAxes(joystick) : SDL_CONTROLLER_AXIS_MAX;
+}
+
+int Gamepad::getNumButtons() const
+{
+	return joystick != nullptr ? SDL_JoystickNumButtons(joystick) : SDL_CONTROLLER_BUTTON_MAX;
 }
 
 SDL_JoystickID Gamepad::getDevID()
@@ -34,7 +34,19 @@ public:
 	//float axisOffset[SDL_JOYSTICK_AXIS_MAX];
 	//float axisDeadZone[SDL_JOYSTICK_AXIS_MAX];
 
+	//Last known raw state, only changes are dispatched to listeners
+	Array<float> axisValues;
+	Array<bool> buttonValues;
+
 	virtual void update();
+	void setAxisValue(int index, float value, uint32 timestamp);
+	void setButtonValue(int index, bool value, uint32 timestamp);
+
+	int getNumAxes() const;
+	int getNumButtons() const;
+	float getAxisValue(int index) const { return axisValues[index]; }
+	bool getButtonValue(int index) const { return buttonValues[index]; }
+
 	SDL_JoystickID getDevID();
 
 	String getName();
@@ -46,7 +58,8 @@ public:
 	{
 	public:
 		virtual ~GamepadListener() {}
-		virtual void gamepadValuesUpdated(Array<float> axes, Array<bool> buttons) {}
+		virtual void gamepadAxisChanged(Gamepad* g, int index, float value, uint32 timestamp) {}
+		virtual void gamepadButtonChanged(Gamepad* g, int index, bool value, uint32 timestamp) {}
 	};
 
 	ListenerList<GamepadListener> gamepadListeners;
@@ -84,7 +97,7 @@ public:
 
 class InputSystemManager :
 	public Thread,
-	public Timer
+	public AsyncUpdater
 {
 public:
 	juce_DeclareSingleton(InputSystemManager, true);
@@ -108,10 +121,12 @@ public:
 	Gamepad* getGamepadForSDL(SDL_Joystick* j);
 	Gamepad* getGamepadForID(SDL_JoystickGUID id);
 	Gamepad* getGamepadForName(String name);
+	Gamepad* getGamepadForDevID(SDL_JoystickID devID);
 
+	void processEvent(const SDL_Event& e);
 
 	void run() override;
-	void timerCallback() override;
+	void handleAsyncUpdate() override;
 
 	class InputManagerListener
 	{
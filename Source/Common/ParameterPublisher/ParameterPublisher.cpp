@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+	ParameterPublisher.cpp
+	Created: 19 Oct 2026 1:52:11am
+	Author:  agent
+
+  ==============================================================================
+*/
+
+juce_ImplementSingleton(ParameterPublisher)
+
+thread_local double ParameterPublisher::currentDeliveryTimestamp = 0;
+
+ParameterPublisher::ParameterPublisher() :
+	Thread("Parameter Publisher"),
+	deliveryRate(100)
+{
+	startThread();
+}
+
+ParameterPublisher::~ParameterPublisher()
+{
+	stopThread(1000);
+	cancelPendingUpdate();
+}
+
+ParameterPublisher::Slot* ParameterPublisher::addSlot(Parameter* p, DeliveryThread deliveryThread)
+{
+	GenericScopedLock lock(slotsLock);
+	return slots.add(new Slot(p, deliveryThread));
+}
+
+void ParameterPublisher::removeSlot(Slot* s)
+{
+	ReferenceCountedObjectPtr<Slot> ref(s);
+	{
+		GenericScopedLock lock(slotsLock);
+		slots.removeObject(s);
+	}
+
+	//a delivery may still hold it, no apply starts after this
+	s->retired = true;
+
+	//removed from one of its own listeners
+	if (s->applyingThread.load() == Thread::getCurrentThreadId()) return;
+
+	int waitedMs = 0;
+	while (s->numApplying.load() > 0)
+	{
+		s->applyDone.wait(10);
+		waitedMs += 10;
+		jassert(waitedMs < 2000); //a listener of this slot is blocked, most likely waiting on the thread removing it
+	}
+}
+
+void ParameterPublisher::run()
+{
+	while (!threadShouldExit())
+	{
+		wait(1000 / jmax(1, deliveryRate));
+
+		deliverPending(PUBLISHER_THREAD);
+
+		bool hasMessageThreadValues = false;
+		{
+			GenericScopedLock lock(slotsLock);
+			for (auto& s : slots)
+			{
+				if (s->deliveryThread == MESSAGE_THREAD && s->pending.load())
+				{
+					hasMessageThreadValues = true;
+					break;
+				}
+			}
+		}
+
+		if (hasMessageThreadValues) triggerAsyncUpdate();
+	}
+}
+
+void ParameterPublisher::handleAsyncUpdate()
+{
+	deliverPending(MESSAGE_THREAD);
+}
+
+void ParameterPublisher::deliverPending(DeliveryThread deliveryThread)
+{
+	ReferenceCountedArray<Slot> dueSlots;
+	{
+		GenericScopedLock lock(slotsLock);
+		for (auto& s : slots)
+		{
+			if (s->deliveryThread == deliveryThread && s->pending.load()) dueSlots.add(s);
+		}
+	}
+
+	//applied outside of the slots lock, listeners may end up removing slots
+	for (auto& s : dueSlots) s->apply();
+}
+
+
+ParameterPublisher::Slot::Slot(Parameter* p, DeliveryThread deliveryThread) :
+	parameter(p),
+	deliveryThread(deliveryThread),
+	sequence(0),
+	numValues(0),
+	timestamp(0),
+	pending(false),
+	retired(false),
+	numApplying(0),
+	applyingThread(nullptr)
+{
+	for (int i = 0; i < maxValues; i++) values[i].store(0);
+}
+
+void ParameterPublisher::Slot::publish(double value)
+{
+	publish(&value, 1);
+}
+
+void ParameterPublisher::Slot::publish(const double* newValues, int num)
+{
+	num = jmin(num, maxValues);
+
+	uint32 seq = sequence.load(std::memory_order_relaxed);
+	sequence.store(seq + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	for (int i = 0; i < num; i++) values[i].store(newValues[i], std::memory_order_relaxed);
+	numValues.store(num, std::memory_order_relaxed);
+	timestamp.store(Time::getMillisecondCounterHiRes(), std::memory_order_relaxed);
+
+	sequence.store(seq + 2, std::memory_order_release);
+	pending.store(true, std::memory_order_release);
+}
+
+bool ParameterPublisher::Slot::read(double* dest, int& num, double& time)
+{
+	for (int tries = 0; tries < 8; tries++)
+	{
+		uint32 seq = sequence.load(std::memory_order_acquire);
+		if (seq & 1) continue;
+
+		num = numValues.load(std::memory_order_relaxed);
+		for (int i = 0; i < num; i++) dest[i] = values[i].load(std::memory_order_relaxed);
+		time = timestamp.load(std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (sequence.load(std::memory_order_relaxed) == seq) return true;
+	}
+
+	return false;
+}
+
+void ParameterPublisher::Slot::apply()
+{
+	//counted before checking retired, so removeSlot either sees this apply or this apply sees the removal
+	numApplying++;
+	applyingThread = Thread::getCurrentThreadId();
+	applyValues();
+	applyingThread = nullptr;
+	if (--numApplying == 0) applyDone.signal();
+}
+
+void ParameterPublisher::Slot::applyValues()
+{
+	if (retired.load() || !pending.exchange(false, std::memory_order_acquire)) return;
+
+	double v[maxValues];
+	int num = 0;
+	double time = 0;
+	if (!read(v, num, time))
+	{
+		pending.store(true); //writer was busy, next round
+		return;
+	}
+
+	if (num == 0) return;
+
+	currentDeliveryTimestamp = time;
+
+	if (applyFunc != nullptr) applyFunc(v, num, time);
+	else if (parameter != nullptr && !parameter.wasObjectDeleted())
+	{
+		if (num == 1) parameter->setValue(v[0]);
+		else
+		{
+			var value;
+			for (int i = 0; i < num; i++) value.append(v[i]);
+			parameter->setValue(value);
+		}
+	}
+
+	currentDeliveryTimestamp = 0;
+}
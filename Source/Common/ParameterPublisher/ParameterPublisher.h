@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+	ParameterPublisher.h
+	Created: 19 Oct 2026 1:52:11am
+	Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//Lets real-time threads (audio callbacks, MIDI or network receivers) publish parameter values without running any listener code.
+//Each published parameter gets a single-writer seqlock slot, and only the latest value is applied on the consumer thread at a bounded rate.
+class ParameterPublisher :
+	public Thread,
+	public AsyncUpdater
+{
+public:
+	juce_DeclareSingleton(ParameterPublisher, true);
+
+	ParameterPublisher();
+	~ParameterPublisher();
+
+	enum DeliveryThread { PUBLISHER_THREAD, MESSAGE_THREAD };
+
+	static const int maxValues = 4;
+
+	class Slot :
+		public ReferenceCountedObject
+	{
+	public:
+		Slot(Parameter* p, DeliveryThread deliveryThread);
+
+		WeakReference<Parameter> parameter;
+		DeliveryThread deliveryThread;
+
+		//optional custom apply, called on the consumer thread instead of setting the parameter directly
+		std::function<void(const double* values, int numValues, double timestamp)> applyFunc;
+
+		std::atomic<uint32> sequence; //odd while being written
+		std::atomic<double> values[maxValues];
+		std::atomic<int> numValues;
+		std::atomic<double> timestamp;
+		std::atomic<bool> pending;
+
+		std::atomic<bool> retired; //removed while possibly still in a delivery copy, never applied again
+		std::atomic<int> numApplying; //no lock is held while listeners run, removeSlot waits for this to drop to 0 instead
+		std::atomic<Thread::ThreadID> applyingThread;
+		WaitableEvent applyDone;
+
+		//real-time side, single writer per slot
+		void publish(double value);
+		void publish(const double* newValues, int num);
+
+		bool read(double* dest, int& num, double& time);
+		void apply();
+		void applyValues();
+
+		JUCE_DECLARE_NON_COPYABLE(Slot)
+	};
+
+	ReferenceCountedArray<Slot> slots;
+	CriticalSection slotsLock; //only for registering and listing due slots, never held while applying nor on the publishing side
+
+	int deliveryRate; //Hz
+	static thread_local double currentDeliveryTimestamp;
+
+	Slot* addSlot(Parameter* p, DeliveryThread deliveryThread = PUBLISHER_THREAD);
+
+	//Waits for an ongoing apply of this slot on another thread, so the owner can be deleted right after.
+	//Listeners fed by PUBLISHER_THREAD slots must never block on the message thread (MessageManagerLock...), slots are removed from there.
+	void removeSlot(Slot* s);
+
+	//inside a listener callback triggered by a delivered value, time at which the value was published (hi-res ms), 0 otherwise
+	static double getDeliveryTimestamp() { return currentDeliveryTimestamp; }
+
+	void run() override;
+	void handleAsyncUpdate() override;
+
+	void deliverPending(DeliveryThread deliveryThread);
+};
@@ -58,6 +58,8 @@ void Condition::onContainerParameterChangedInternal(Parameter* p)
 	BaseItem::onContainerParameterChangedInternal(p);
 	if (p == enabled)
 	{
+		//listeners update their enabled count first, so the invalidation below is evaluated without this condition
+		conditionListeners.call(&ConditionListener::conditionEnableChanged, this);
 		for (int i = 0; i < getMultiplexCount(); i++) setValid(i, false);
 	}
 }
@@ -37,6 +37,7 @@ public:
 		virtual ~ConditionListener() {}
 		virtual void conditionValidationChanged(Condition *, int multiplexIndex, bool dispatchOnChangeOnly) {}
 		virtual void conditionSourceChanged(Condition *) {}
+		virtual void conditionEnableChanged(Condition *) {}
 	};
 
 	ListenerList<ConditionListener> conditionListeners;
@@ -18,6 +18,7 @@ ConditionManager::ConditionManager(Multiplex* multiplex) :
 	forceDisabled(false),
 	useValidationProgress(false),
 	isCheckingOtherConditionsWithSameSource(false),
+	numEnabledConditions(0),
 	conditionManagerAsyncNotifier(10)
 {
 	canBeCopiedAndPasted = true;
@@ -32,6 +33,7 @@ ConditionManager::ConditionManager(Multiplex* multiplex) :
 	validationTargets.fill(false);
 
 	sequentialConditionIndices.resize(getMultiplexCount());
+	numValidConditions.resize(getMultiplexCount());
 
 	managerFactory = &factory;
 	factory.defs.add(MultiplexTargetDefinition<Condition>::createDef<StandardCondition>("", StandardCondition::getTypeStringStatic(false), multiplex));
@@ -61,14 +63,19 @@ SEQUENTIAL will check the first, and when it gets validated, will check the next
 	conditionOperator->addOption("OR", ConditionOperator::OR);
 	conditionOperator->addOption("SEQUENTIAL", ConditionOperator::SEQUENTIAL);
 	conditionOperator->hideInEditor = true;
+
+	validationSchedulerRef = static_cast<Inspectable*>(this);
 }
 
 ConditionManager::~ConditionManager()
 {
+	stopAllValidationDelays();
 }
 
 void ConditionManager::multiplexCountChanged()
 {
+	stopAllValidationDelays();
+
 	isValids.resize(getMultiplexCount());
 	validationProgresses.resize(getMultiplexCount());
 	validationTargets.resize(getMultiplexCount());
@@ -78,6 +85,9 @@ void ConditionManager::multiplexCountChanged()
 	validationProgresses.fill(0);
 	validationTargets.fill(false);
 	sequentialConditionIndices.fill(0);
+
+	//conditions reset their validity without notifying, so don't rely on their current state
+	rebuildValidationCounts(true);
 }
 
 void ConditionManager::multiplexPreviewIndexChanged()
@@ -134,6 +144,9 @@ void ConditionManager::addItemInternal(Condition* c, var data)
 		Action* a = ControllableUtil::findParentAs<Action>(this);
 		sc->sourceTarget->warningResolveInspectable = a != nullptr ? (Inspectable*)a : this;
 	}
+
+	rebuildValidationCounts();
+	rebuildSourceConditionsMap();
 }
 
 void ConditionManager::removeItemInternal(Condition* c)
@@ -141,6 +154,24 @@ void ConditionManager::removeItemInternal(Condition* c)
 	c->removeConditionListener(this);
 	conditionOperator->hideInEditor = items.size() <= 1;
 
+	//Remove this condition's contribution, it may still be in the items at this point
+	{
+		GenericScopedLock lock(validationCountLock);
+		if (countedValids.contains(c))
+		{
+			Array<bool>& counted = countedValids.getReference(c);
+			for (int i = 0; i < counted.size() && i < numValidConditions.size(); i++) if (counted[i]) numValidConditions.getReference(i)--;
+			countedValids.remove(c);
+			if (c->enabled->boolValue()) numEnabledConditions--;
+		}
+	}
+
+	if (StandardCondition* sc = dynamic_cast<StandardCondition*>(c))
+	{
+		const ScopedWriteLock lock(sourceConditionsLock);
+		for (HashMap<Controllable*, Array<StandardCondition*>>::Iterator it(sourceConditionsMap); it.next();) sourceConditionsMap.getReference(it.getKey()).removeAllInstancesOf(sc);
+	}
+
 	sequentialConditionIndices.fill(0);
 	conditionManagerAsyncNotifier.addMessage(new ConditionManagerEvent(ConditionManagerEvent::SEQUENTIAL_CONDITION_INDEX_CHANGED, this));
 
@@ -196,6 +227,77 @@ void ConditionManager::setValidationProgress(int multiplexIndex, float value)
 	if (!isMultiplexed()) validationProgressFeedback->setValue(value);
 }
 
+float ConditionManager::getValidationProgress(int multiplexIndex)
+{
+	GenericScopedLock lock(validationLock);
+
+	//Computed on read while a delay is pending, nothing is updated in between
+	double deadline = validationDeadlines[multiplexIndex];
+	if (deadline <= 0) return validationProgresses[multiplexIndex];
+
+	double start = validationStartTimes[multiplexIndex];
+	float rel = deadline > start ? jlimit<float>(0, 1, (float)((Time::getMillisecondCounterHiRes() - start) / (deadline - start))) : 1;
+	return validationTargets[multiplexIndex] ? rel : 1 - rel;
+}
+
+void ConditionManager::startValidationDelay(int multiplexIndex, bool targetIsValid)
+{
+	double delay = (targetIsValid ? validationTime->floatValue() : invalidationTime->floatValue()) * 1000.0;
+	double now = Time::getMillisecondCounterHiRes();
+
+	{
+		GenericScopedLock lock(validationLock);
+		if (validationDeadlines.size() < getMultiplexCount())
+		{
+			validationStartTimes.resize(getMultiplexCount());
+			validationDeadlines.resize(getMultiplexCount());
+		}
+
+		validationStartTimes.set(multiplexIndex, now);
+		validationDeadlines.set(multiplexIndex, now + delay);
+	}
+
+	ConditionValidationScheduler::getInstance()->schedule(this, multiplexIndex, now + delay);
+}
+
+void ConditionManager::stopValidationDelay(int multiplexIndex)
+{
+	{
+		GenericScopedLock lock(validationLock);
+		if (validationDeadlines[multiplexIndex] <= 0) return;
+		validationDeadlines.set(multiplexIndex, 0);
+	}
+
+	if (ConditionValidationScheduler* s = ConditionValidationScheduler::getInstanceWithoutCreating()) s->cancel(this, multiplexIndex);
+}
+
+void ConditionManager::stopAllValidationDelays()
+{
+	if (ConditionValidationScheduler* s = ConditionValidationScheduler::getInstanceWithoutCreating()) s->cancelAll(this);
+
+	GenericScopedLock lock(validationLock);
+	validationDeadlines.fill(0);
+}
+
+void ConditionManager::validationDeadlineReached(int multiplexIndex, double deadline)
+{
+	{
+		GenericScopedLock lock(validationLock);
+		if (validationDeadlines[multiplexIndex] != deadline) return; //cancelled or restarted since it expired
+		validationDeadlines.set(multiplexIndex, 0);
+	}
+
+	bool targetIsValid = validationTargets[multiplexIndex];
+	if (useValidationProgress) setValidationProgress(multiplexIndex, targetIsValid ? 1 : 0);
+	setValid(multiplexIndex, targetIsValid);
+}
+
+void ConditionManager::updateValidationProgressFeedback()
+{
+	if (isMultiplexed()) return;
+	validationProgressFeedback->setValue(getValidationProgress(0));
+}
+
 void ConditionManager::setSequentialConditionIndices(int index, int multiplexIndex)
 {
 	if (multiplexIndex != -1) sequentialConditionIndices.set(multiplexIndex, index);
@@ -209,6 +311,62 @@ void ConditionManager::forceCheck()
 	for (auto& i : items) i->forceCheck();
 }
 
+void ConditionManager::rebuildValidationCounts(bool resetValids)
+{
+	GenericScopedLock lock(validationCountLock);
+
+	numValidConditions.resize(getMultiplexCount());
+	numValidConditions.fill(0);
+	numEnabledConditions = 0;
+	countedValids.clear();
+
+	for (auto& c : items)
+	{
+		bool isEnabled = c->enabled->boolValue();
+		if (isEnabled) numEnabledConditions++;
+
+		Array<bool> counted;
+		counted.resize(getMultiplexCount());
+		for (int i = 0; i < getMultiplexCount(); i++)
+		{
+			bool v = !resetValids && isEnabled && c->getIsValid(i);
+			counted.set(i, v);
+			if (v) numValidConditions.getReference(i)++;
+		}
+
+		countedValids.set(c, counted);
+	}
+}
+
+void ConditionManager::updateValidationCount(Condition* c, int multiplexIndex)
+{
+	GenericScopedLock lock(validationCountLock);
+
+	if (!isPositiveAndBelow(multiplexIndex, numValidConditions.size()) || !countedValids.contains(c)) return;
+
+	Array<bool>& counted = countedValids.getReference(c);
+	if (multiplexIndex >= counted.size()) counted.resize(numValidConditions.size());
+
+	bool v = c->enabled->boolValue() && c->getIsValid(multiplexIndex);
+	if (counted[multiplexIndex] == v) return;
+
+	counted.set(multiplexIndex, v);
+	numValidConditions.getReference(multiplexIndex) += v ? 1 : -1;
+}
+
+void ConditionManager::rebuildSourceConditionsMap()
+{
+	//built aside and swapped in, readers only wait for the swap
+	HashMap<Controllable*, Array<StandardCondition*>> newMap;
+	for (auto& i : items)
+	{
+		if (StandardCondition* sc = dynamic_cast<StandardCondition*>(i)) newMap.getReference(sc->sourceControllable.get()).add(sc);
+	}
+
+	const ScopedWriteLock lock(sourceConditionsLock);
+	sourceConditionsMap.swapWith(newMap);
+}
+
 void ConditionManager::checkAllConditions(int multiplexIndex, bool emptyIsValid, bool dispatchOnlyOnValidationChange, int sourceConditionIndex)
 {
 	bool valid = false;
@@ -235,6 +393,7 @@ void ConditionManager::checkAllConditions(int multiplexIndex, bool emptyIsValid,
 
 	if ((valid && validationTime->floatValue() == 0) || (!valid && invalidationTime->floatValue() == 0))
 	{
+		stopValidationDelay(multiplexIndex);
 		setValid(multiplexIndex, valid, dispatchOnlyOnValidationChange);
 		validationTargets.set(multiplexIndex, valid);
 
@@ -250,12 +409,11 @@ void ConditionManager::checkAllConditions(int multiplexIndex, bool emptyIsValid,
 			setValidationProgress(multiplexIndex, valid ? 0 : 1);
 			validationTargets.set(multiplexIndex, valid);
 			
-			prevTimerTimes.set(multiplexIndex, Time::getMillisecondCounterHiRes() / 1000.0);
-			startTimer(multiplexIndex, 20);
+			startValidationDelay(multiplexIndex, valid);
 		}
 		else
 		{
-			stopTimer(multiplexIndex);
+			stopValidationDelay(multiplexIndex);
 			setValidationProgress(multiplexIndex, valid);
 			validationTargets.set(multiplexIndex, valid);
 		}
@@ -277,25 +435,48 @@ void ConditionManager::checkAllConditions(int multiplexIndex, bool emptyIsValid,
 
 void ConditionManager::conditionValidationChanged(Condition* c, int multiplexIndex, bool dispatchOnChangeOnly)
 {
+	updateValidationCount(c, multiplexIndex);
+
 	if (isCheckingOtherConditionsWithSameSource) return;
 
 	if (StandardCondition* sc = dynamic_cast<StandardCondition*>(c))
 	{
-		isCheckingOtherConditionsWithSameSource = true;
-		for (auto& i : items)
+		Controllable* source = sc->sourceControllable.get();
+		const ScopedReadLock lock(sourceConditionsLock);
+		if (sourceConditionsMap.contains(source) && sourceConditionsMap.getReference(source).size() > 1)
 		{
-			if (i == c) continue;
-			if (StandardCondition* otherSC = dynamic_cast<StandardCondition*>(i))
+			isCheckingOtherConditionsWithSameSource = true;
+			for (auto& otherSC : sourceConditionsMap.getReference(source))
 			{
-				if (sc->sourceControllable == otherSC->sourceControllable) otherSC->checkComparator(multiplexIndex);
+				if (otherSC != sc) otherSC->checkComparator(multiplexIndex);
 			}
+			isCheckingOtherConditionsWithSameSource = false;
 		}
-		isCheckingOtherConditionsWithSameSource = false;
 	}
 
 	checkAllConditions(multiplexIndex, false, dispatchOnChangeOnly, items.indexOf(c));
 }
 
+void ConditionManager::conditionSourceChanged(Condition*)
+{
+	rebuildSourceConditionsMap();
+}
+
+void ConditionManager::conditionEnableChanged(Condition* c)
+{
+	{
+		GenericScopedLock lock(validationCountLock);
+		numEnabledConditions = 0;
+		for (auto& i : items) if (i->enabled->boolValue()) numEnabledConditions++;
+	}
+
+	for (int i = 0; i < getMultiplexCount(); i++) updateValidationCount(c, i);
+
+	//enabling a condition that is already invalid does not go through conditionValidationChanged
+	if (Engine::mainEngine->isLoadingFile || Engine::mainEngine->isClearing) return;
+	for (int i = 0; i < getMultiplexCount(); i++) checkAllConditions(i);
+}
+
 void ConditionManager::onContainerParameterChanged(Parameter* p)
 {
 	if (p == conditionOperator)
@@ -314,90 +495,36 @@ void ConditionManager::onContainerParameterChanged(Parameter* p)
 	}
 }
 
-void ConditionManager::timerCallback(int id)
-{
-	if (!useValidationProgress)
-	{
-		setValid(id, validationTargets[id]);
-		stopTimer(id);
-		return;
-	}
-
-	bool targetIsValid = validationTargets[id];
-
-
-	double curTime = Time::getMillisecondCounterHiRes() / 1000.0;
-	float diffProgress = (curTime - prevTimerTimes[id]) / (targetIsValid ? validationTime->floatValue() : invalidationTime->floatValue());
-
-	if (!targetIsValid) diffProgress = -diffProgress;
-	float progress = jlimit<float>(0, 1, validationProgresses[id] + diffProgress);
-
-	setValidationProgress(id, progress);
-	prevTimerTimes.set(id, curTime);
-
-	if (validationProgresses[id] == (int)targetIsValid)
-	{
-		setValid(id, validationTargets[id]);
-		stopTimer(id);
-	}
-}
-
 void ConditionManager::afterLoadJSONDataInternal()
 {
+	rebuildValidationCounts();
+	rebuildSourceConditionsMap();
 	for (int i = 0; i < getMultiplexCount(); i++) checkAllConditions(i);
 }
 
 bool ConditionManager::areAllConditionsValid(int multiplexIndex, bool emptyIsValid)
 {
-	if (items.size() == 0) return emptyIsValid;
-
-	int conditionsChecked = 0;
-	for (auto& c : items)
-	{
-		if (!c->enabled->boolValue()) continue;
-		if (!c->getIsValid(multiplexIndex)) return false;
-		conditionsChecked++;
-	}
-
-	if (conditionsChecked == 0) return emptyIsValid;
-	return true;
+	GenericScopedLock lock(validationCountLock);
+	if (numEnabledConditions == 0) return emptyIsValid;
+	return numValidConditions[multiplexIndex] == numEnabledConditions;
 }
 
 bool ConditionManager::isAtLeastOneConditionValid(int multiplexIndex, bool emptyIsValid)
 {
-	if (items.size() == 0) return emptyIsValid;
-
-	int conditionsChecked = 0;
-	for (auto& c : items)
-	{
-		if (!c->enabled->boolValue()) continue;
-		if (c->getIsValid(multiplexIndex)) return true;
-		conditionsChecked++;
-	}
-
-	if (conditionsChecked == 0) return emptyIsValid;
-	return false;
+	GenericScopedLock lock(validationCountLock);
+	if (numEnabledConditions == 0) return emptyIsValid;
+	return numValidConditions[multiplexIndex] > 0;
 }
 
 int ConditionManager::getNumEnabledConditions()
 {
-	int result = 0;
-	for (auto& c : items)
-	{
-		if (c->enabled->boolValue()) result++;
-	}
-	return result;
+	return numEnabledConditions;
 }
 
 int ConditionManager::getNumValidConditions(int multiplexIndex)
 {
-	int result = 0;
-	for (auto& c : items)
-	{
-		if (!c->enabled->boolValue()) continue;
-		if (c->getIsValid(multiplexIndex)) result++;
-	}
-	return result;
+	GenericScopedLock lock(validationCountLock);
+	return numValidConditions[multiplexIndex];
 }
 
 bool ConditionManager::getIsValid(int multiplexIndex, bool emptyIsValid)
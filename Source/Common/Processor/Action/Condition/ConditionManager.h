@@ -10,11 +10,12 @@
 
 #pragma once
 
+class StandardCondition;
+
 class ConditionManager :
 	public MultiplexTarget,
 	public BaseManager<Condition>,
-	public Condition::ConditionListener,
-	public MultiTimer
+	public Condition::ConditionListener
 {
 public:
 	ConditionManager(Multiplex* multiplex);
@@ -35,13 +36,26 @@ public:
 	Array<bool> isValids;
 	Array<float> validationProgresses;
 	Array<bool> validationTargets;
-	Array<double> prevTimerTimes;
+
+	//Pending validation delays, absolute times in Time::getMillisecondCounterHiRes() base, served by the ConditionValidationScheduler
+	Array<double> validationStartTimes;
+	Array<double> validationDeadlines;
+	CriticalSection validationLock;
+	WeakReference<Inspectable> validationSchedulerRef; //created here on the message thread, the scheduler copies it to check this manager still exists when dispatching
 
 	bool forceDisabled;
 	bool useValidationProgress;
 
 	//sameSource sync check to avoid parameterListener order bug when 2 conditions have the same source but different operators
 	bool isCheckingOtherConditionsWithSameSource;
+	HashMap<Controllable*, Array<StandardCondition*>> sourceConditionsMap;
+	ReadWriteLock sourceConditionsLock; //written on the message thread, read from input threads
+
+	//Incremental AND / OR evaluation, number of enabled and valid conditions per multiplex index
+	Array<int> numValidConditions;
+	int numEnabledConditions;
+	HashMap<Condition*, Array<bool>> countedValids; //last state taken into account for each condition
+	SpinLock validationCountLock; //conditions can change from any input thread
 
 	void multiplexCountChanged() override;
 	void multiplexPreviewIndexChanged() override;
@@ -56,11 +70,22 @@ public:
 
 	void setValid(int multiplexIndex, bool value, bool dispatchOnlyOnValidationChange = true);
 	void setValidationProgress(int multiplexIndex, float value);
+	float getValidationProgress(int multiplexIndex);
+
+	void startValidationDelay(int multiplexIndex, bool targetIsValid);
+	void stopValidationDelay(int multiplexIndex);
+	void stopAllValidationDelays();
+	void validationDeadlineReached(int multiplexIndex, double deadline);
+	void updateValidationProgressFeedback();
 
 	void setSequentialConditionIndices(int index, int multiplexIndex = -1);
 
 	void forceCheck();
 
+	void rebuildValidationCounts(bool resetValids = false);
+	void updateValidationCount(Condition* c, int multiplexIndex);
+	void rebuildSourceConditionsMap();
+
 	void checkAllConditions(int multiplexIndex, bool emptyIsValid = false, bool dispatchOnlyOnValidationChange = true, int sourceConditionIndex = -1);
 
 	bool areAllConditionsValid(int multiplexIndex, bool emptyIsValid = false);
@@ -74,11 +99,11 @@ public:
 	void dispatchConditionValidationChanged(int multiplexIndex, bool dispatchOnChangeOnly);
 
 	void conditionValidationChanged(Condition*, int multiplexIndex, bool dispatchOnChangeOnly) override;
+	void conditionSourceChanged(Condition*) override;
+	void conditionEnableChanged(Condition*) override;
 
 	void onContainerParameterChanged(Parameter*) override;
 
-	virtual void timerCallback(int id) override;
-
 	void afterLoadJSONDataInternal() override;
 
 	InspectableEditor* getEditorInternal(bool isRoot, Array<Inspectable*> inspectables = Array<Inspectable*>()) override;
@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+	ConditionValidationScheduler.cpp
+	Created: 19 Oct 2026 1:42:37am
+	Author:  agent
+
+  ==============================================================================
+*/
+
+#include "Common/Processor/ProcessorIncludes.h"
+
+juce_ImplementSingleton(ConditionValidationScheduler)
+
+ConditionValidationScheduler::ConditionValidationScheduler() :
+	Thread("Condition Validation")
+{
+	startThread();
+}
+
+ConditionValidationScheduler::~ConditionValidationScheduler()
+{
+	stopThread(1000);
+}
+
+void ConditionValidationScheduler::schedule(ConditionManager* manager, int multiplexIndex, double time)
+{
+	{
+		GenericScopedLock lock(deadlinesLock);
+		for (int i = deadlines.size() - 1; i >= 0; i--)
+		{
+			if (deadlines[i].manager == manager && deadlines[i].multiplexIndex == multiplexIndex) deadlines.remove(i);
+		}
+
+		DeadlineComparator comparator;
+		deadlines.addSorted(comparator, { time, manager, manager->validationSchedulerRef, multiplexIndex, !manager->isMultiplexed() });
+	}
+
+	notify();
+}
+
+void ConditionValidationScheduler::cancel(ConditionManager* manager, int multiplexIndex)
+{
+	GenericScopedLock lock(deadlinesLock);
+	for (int i = deadlines.size() - 1; i >= 0; i--)
+	{
+		if (deadlines[i].manager == manager && deadlines[i].multiplexIndex == multiplexIndex) deadlines.remove(i);
+	}
+}
+
+void ConditionValidationScheduler::cancelAll(ConditionManager* manager)
+{
+	GenericScopedLock lock(deadlinesLock);
+	for (int i = deadlines.size() - 1; i >= 0; i--)
+	{
+		if (deadlines[i].manager == manager) deadlines.remove(i);
+	}
+}
+
+void ConditionValidationScheduler::run()
+{
+	while (!threadShouldExit())
+	{
+		double nextTime = -1;
+		Array<Deadline> expired;
+		Array<WeakReference<Inspectable>> feedbackManagers;
+
+		{
+			GenericScopedLock lock(deadlinesLock);
+			const double now = Time::getMillisecondCounterHiRes();
+
+			int numExpired = 0;
+			while (numExpired < deadlines.size() && deadlines.getReference(numExpired).time <= now) numExpired++;
+			expired.addArray(deadlines, 0, numExpired);
+			deadlines.removeRange(0, numExpired);
+
+			//Progress is computed lazily from the deadlines, only the feedback parameter needs a refresh
+			for (auto& d : deadlines) if (d.refreshFeedback) feedbackManagers.addIfNotAlreadyThere(d.managerRef);
+
+			if (!deadlines.isEmpty()) nextTime = deadlines.getReference(0).time;
+		}
+
+		//Nothing is fired from this thread, consequences may lock the message thread while it is waiting on a manager
+		if (!expired.isEmpty() || !feedbackManagers.isEmpty())
+		{
+			MessageManager::callAsync([expired, feedbackManagers]()
+				{
+					for (auto& d : expired)
+					{
+						if (ConditionManager* m = dynamic_cast<ConditionManager*>(d.managerRef.get())) m->validationDeadlineReached(d.multiplexIndex, d.time);
+					}
+
+					for (auto& ref : feedbackManagers)
+					{
+						if (ConditionManager* m = dynamic_cast<ConditionManager*>(ref.get())) m->updateValidationProgressFeedback();
+					}
+				});
+		}
+
+		if (nextTime < 0)
+		{
+			wait(-1);
+			continue;
+		}
+
+		int waitMs = (int)std::ceil(nextTime - Time::getMillisecondCounterHiRes());
+		if (!feedbackManagers.isEmpty()) waitMs = jmin(waitMs, feedbackRefreshMs);
+		if (waitMs > 0) wait(waitMs);
+	}
+}
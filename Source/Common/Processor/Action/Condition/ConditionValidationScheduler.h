@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+	ConditionValidationScheduler.h
+	Created: 19 Oct 2026 1:42:37am
+	Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class ConditionManager;
+
+//Tracks validation / invalidation delays of all condition managers from a single thread, instead of polling with message thread timers.
+//Expired deadlines are dispatched to the message thread, where the consequences have always been triggered
+class ConditionValidationScheduler :
+	public Thread
+{
+public:
+	juce_DeclareSingleton(ConditionValidationScheduler, true);
+
+	ConditionValidationScheduler();
+	~ConditionValidationScheduler();
+
+	struct Deadline
+	{
+		double time; //absolute, in Time::getMillisecondCounterHiRes() base, also identifies the delay when it is dispatched
+		ConditionManager* manager;
+		WeakReference<Inspectable> managerRef; //checked on the message thread, the manager may be deleted before the dispatch
+		int multiplexIndex;
+		bool refreshFeedback; //only non-multiplexed managers have a progress parameter to refresh
+	};
+
+	struct DeadlineComparator
+	{
+		static int compareElements(const Deadline& a, const Deadline& b) { return a.time < b.time ? -1 : (a.time > b.time ? 1 : 0); }
+	};
+
+	Array<Deadline> deadlines; //sorted by time
+	CriticalSection deadlinesLock;
+
+	const int feedbackRefreshMs = 33;
+
+	void schedule(ConditionManager* manager, int multiplexIndex, double time);
+	void cancel(ConditionManager* manager, int multiplexIndex);
+	void cancelAll(ConditionManager* manager);
+
+	void run() override;
+};
@@ -42,9 +42,15 @@ void BaseComparator::setReferenceParam(Parameter* p)
 	if (reference != nullptr)
 	{
 		addParameter(reference);
-		if (isMultiplexed()) refLink.reset(new ParameterLink(reference, multiplex));
+		if (isMultiplexed())
+		{
+			refLink.reset(new ParameterLink(reference, multiplex));
+			refLink->addParameterLinkListener(this);
+		}
 	}
 
+	invalidateReferenceCache();
+
 	comparatorNotifier.addMessage(new ComparatorEvent(ComparatorEvent::REFERENCE_CHANGED, this));
 }
 
@@ -59,6 +65,7 @@ void BaseComparator::updateReferenceRange(Parameter* sourceParam)
 {
 	if (sourceParam->hasRange()) reference->setRange(sourceParam->minimumValue, sourceParam->maximumValue);
 	else reference->clearRange();
+	invalidateReferenceCache();
 }
 
 var BaseComparator::getJSONData()
@@ -73,6 +80,58 @@ void BaseComparator::loadJSONDataInternal(var data)
 	if (refLink != nullptr) refLink->loadJSONData(data.getProperty("refLink", var()));
 }
 
+var BaseComparator::getReferenceValue(int multiplexIndex)
+{
+	if (!isMultiplexed() || refLink == nullptr) return reference->getValue();
+	if (!canCacheReference()) return refLink->getLinkedValue(multiplexIndex);
+
+	if (multiplexIndex >= refCacheValid.size())
+	{
+		refCache.resize(jmax(multiplexIndex + 1, getMultiplexCount()));
+		refCacheValid.resize(refCache.size());
+	}
+
+	if (!refCacheValid[multiplexIndex])
+	{
+		refCache.set(multiplexIndex, refLink->getLinkedValue(multiplexIndex));
+		refCacheValid.set(multiplexIndex, true);
+	}
+
+	return refCache.getReference(multiplexIndex);
+}
+
+bool BaseComparator::canCacheReference() const
+{
+	//Only link types that notify every change of their linked value can be cached
+	switch (refLink->linkType)
+	{
+	case ParameterLink::NONE: return reference->type != Parameter::STRING; //strings may contain replacement tokens
+	case ParameterLink::INDEX:
+	case ParameterLink::INDEX_ZERO:
+	case ParameterLink::MULTIPLEX_LIST:
+		return true;
+	default:
+		return false;
+	}
+}
+
+void BaseComparator::invalidateReferenceCache(int multiplexIndex)
+{
+	GenericScopedLock lock(compareLock);
+	if (multiplexIndex < 0) refCacheValid.fill(false);
+	else if (multiplexIndex < refCacheValid.size()) refCacheValid.set(multiplexIndex, false);
+}
+
+void BaseComparator::linkUpdated(ParameterLink* pLink)
+{
+	invalidateReferenceCache();
+}
+
+void BaseComparator::listItemUpdated(ParameterLink* pLink, int multiplexIndex)
+{
+	invalidateReferenceCache(multiplexIndex);
+}
+
 bool BaseComparator::compare(Parameter* sourceParam, int multiplexIndex)
 {
 	GenericScopedLock lock(compareLock);
@@ -92,6 +151,10 @@ void BaseComparator::onContainerParameterChanged(Parameter * p)
 		compareFunctionChanged();
 
 	}
+	else if (p == reference)
+	{
+		invalidateReferenceCache();
+	}
 	ControllableContainer::onContainerParameterChanged(p);
 }
 
@@ -10,12 +10,14 @@
 
 #pragma once
 
-class ParameterLink;
+#include "Common/ParameterLink/ParameterLink.h"
+
 class BaseComparatorUI;
 
 class BaseComparator :
 	public ControllableContainer,
-	public MultiplexTarget
+	public MultiplexTarget,
+	public ParameterLink::ParameterLinkListener
 {
 public:
 	BaseComparator(Multiplex * multiplex);
@@ -30,7 +32,10 @@ public:
 
 	const Identifier changeId = "ch";
 
-	
+	//Reference values resolved from the link, per multiplex index
+	Array<var> refCache;
+	Array<bool> refCacheValid;
+
 	void setReferenceParam(Parameter*); //go through this to have automatic link for multiplex
 
 	void addCompareOption(const String& name, const Identifier& func);
@@ -39,6 +44,13 @@ public:
 	var getJSONData() override;
 	void loadJSONDataInternal(var data) override;
 
+	var getReferenceValue(int multiplexIndex);
+	bool canCacheReference() const;
+	virtual void invalidateReferenceCache(int multiplexIndex = -1);
+
+	void linkUpdated(ParameterLink* pLink) override;
+	void listItemUpdated(ParameterLink* pLink, int multiplexIndex) override;
+
 	bool compare(Parameter* sourceParam, int multiplexIndex = 0);
 	virtual bool compareInternal(Parameter* sourceParam, int multiplexIndex = 0) = 0; // to override
 
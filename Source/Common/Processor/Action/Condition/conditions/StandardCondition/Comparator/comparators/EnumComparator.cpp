@@ -9,7 +9,8 @@
 */
 
 EnumComparator::EnumComparator(Parameter * sourceParam, Multiplex* multiplex) :
-	BaseComparator(multiplex)
+	BaseComparator(multiplex),
+	compareFunc(nullptr)
 {
 	EnumParameter* ep = (EnumParameter *)sourceParam;
 
@@ -21,6 +22,7 @@ EnumComparator::EnumComparator(Parameter * sourceParam, Multiplex* multiplex) :
 	addCompareOption("=", equalsId);
 	addCompareOption("!=", differentId);
 	addCompareOption("Change", changeId);
+	compareFunctionChanged();
 
 	enumRef->setValue(ep->value, false, true, true);
 }
@@ -29,10 +31,16 @@ EnumComparator::~EnumComparator()
 {
 }
 
+void EnumComparator::compareFunctionChanged()
+{
+	if (currentFunctionId == equalsId) compareFunc = [](const var& v, const var& r) { return v == r; };
+	else if (currentFunctionId == differentId) compareFunc = [](const var& v, const var& r) { return v != r; };
+	else compareFunc = nullptr;
+}
+
 bool EnumComparator::compareInternal(Parameter* sourceParam, int multiplexIndex)
 {
-	var value = isMultiplexed() ? refLink->getLinkedValue(multiplexIndex) : enumRef->getValueData();
-	if (currentFunctionId == equalsId) return ((EnumParameter*)sourceParam)->getValueData() == value;
-	if (currentFunctionId == differentId) return ((EnumParameter *)sourceParam)->getValueData() != value;
-	return false;
+	if (compareFunc == nullptr) return false;
+	var value = isMultiplexed() ? getReferenceValue(multiplexIndex) : enumRef->getValueData();
+	return compareFunc(((EnumParameter*)sourceParam)->getValueData(), value);
 }
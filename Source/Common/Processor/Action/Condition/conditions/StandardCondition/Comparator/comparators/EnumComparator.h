@@ -23,5 +23,10 @@ public:
 
 	EnumParameter * enumRef;
 
+	typedef bool (*CompareFunc)(const var& value, const var& ref);
+	CompareFunc compareFunc;
+
+	virtual void compareFunctionChanged() override;
+
 	virtual bool compareInternal(Parameter* sourceParam, int multiplexIndex = 0) override;
 };
\ No newline at end of file
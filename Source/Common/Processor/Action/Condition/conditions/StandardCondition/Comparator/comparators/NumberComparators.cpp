@@ -10,7 +10,9 @@
 
 NumberComparator::NumberComparator(Parameter* sourceParam, Multiplex* multiplex) :
 	BaseComparator(multiplex),
-	isFloat(dynamic_cast<FloatParameter*>(sourceParam) != nullptr)
+	isFloat(dynamic_cast<FloatParameter*>(sourceParam) != nullptr),
+	compareFunc(nullptr),
+	isDiffFunction(false)
 {
 
 	sourceRange.append(sourceParam->minimumValue);
@@ -36,6 +38,8 @@ NumberComparator::NumberComparator(Parameter* sourceParam, Multiplex* multiplex)
 	addCompareOption("Diff <", diffLessId);
 	addCompareOption("Range", inRangeId);
 	addCompareOption("Change", changeId);
+
+	updateCompareFunc();
 }
 
 NumberComparator::~NumberComparator()
@@ -45,6 +49,67 @@ NumberComparator::~NumberComparator()
 void NumberComparator::compareFunctionChanged()
 {
 	setupReferenceParam();
+	updateCompareFunc();
+}
+
+void NumberComparator::updateCompareFunc()
+{
+	GenericScopedLock lock(compareLock);
+
+	isDiffFunction = currentFunctionId == diffGreaterId || currentFunctionId == diffLessId;
+
+	if (currentFunctionId == equalsId)				compareFunc = [](float v, float r, float) { return v == r; };
+	else if (currentFunctionId == differentId)		compareFunc = [](float v, float r, float) { return v != r; };
+	else if (currentFunctionId == greaterId)		compareFunc = [](float v, float r, float) { return v > r; };
+	else if (currentFunctionId == lessId)			compareFunc = [](float v, float r, float) { return v < r; };
+	else if (currentFunctionId == greaterOrEqualId)	compareFunc = [](float v, float r, float) { return v >= r; };
+	else if (currentFunctionId == lessOrEqualId)	compareFunc = [](float v, float r, float) { return v <= r; };
+	else if (currentFunctionId == moduloEqualId)	compareFunc = [](float v, float r1, float r2) { return r1 == 0 ? false : fmodf(v, r1) == r2; };
+	else if (currentFunctionId == moduloGreaterId)	compareFunc = [](float v, float r1, float r2) { return r1 == 0 ? false : fmodf(v, r1) > r2; };
+	else if (currentFunctionId == moduloLessId)		compareFunc = [](float v, float r1, float r2) { return r1 == 0 ? false : fmodf(v, r1) < r2; };
+	else if (currentFunctionId == floorEqualId)		compareFunc = [](float v, float r1, float r2) { return r1 == 0 ? false : floorf(v / r1) == r2; };
+	else if (currentFunctionId == floorGreaterId)	compareFunc = [](float v, float r1, float r2) { return r1 == 0 ? false : floorf(v / r1) > r2; };
+	else if (currentFunctionId == floorLessId)		compareFunc = [](float v, float r1, float r2) { return r1 == 0 ? false : floorf(v / r1) < r2; };
+	else if (currentFunctionId == inRangeId)		compareFunc = [](float v, float r1, float r2) { return v >= r1 && v <= r2; };
+	else if (currentFunctionId == diffGreaterId)	compareFunc = [](float diff, float r, float) { return diff > r; };
+	else if (currentFunctionId == diffLessId)		compareFunc = [](float diff, float r, float) { return diff < r; };
+	else compareFunc = nullptr;
+}
+
+Point<float> NumberComparator::getNumericReference(int multiplexIndex)
+{
+	if (!isMultiplexed() || refLink == nullptr)
+	{
+		if (reference->type == Parameter::POINT2D) return ((Point2DParameter*)reference)->getPoint();
+		return Point<float>(reference->floatValue(), 0);
+	}
+
+	if (multiplexIndex >= numRefCacheValid.size())
+	{
+		numRefCache.resize(jmax(multiplexIndex + 1, getMultiplexCount()));
+		numRefCacheValid.resize(numRefCache.size());
+	}
+
+	if (numRefCacheValid[multiplexIndex]) return numRefCache[multiplexIndex];
+
+	var value = getReferenceValue(multiplexIndex);
+	Point<float> result = value.isArray() ? Point<float>(value[0], value[1]) : Point<float>(value, 0);
+
+	if (canCacheReference())
+	{
+		numRefCache.set(multiplexIndex, result);
+		numRefCacheValid.set(multiplexIndex, true);
+	}
+
+	return result;
+}
+
+void NumberComparator::invalidateReferenceCache(int multiplexIndex)
+{
+	GenericScopedLock lock(compareLock);
+	BaseComparator::invalidateReferenceCache(multiplexIndex);
+	if (multiplexIndex < 0) numRefCacheValid.fill(false);
+	else if (multiplexIndex < numRefCacheValid.size()) numRefCacheValid.set(multiplexIndex, false);
 }
 
 void NumberComparator::setupReferenceParam()
@@ -74,28 +139,18 @@ void NumberComparator::setupReferenceParam()
 
 bool NumberComparator::compareInternal(Parameter* sourceParam, int multiplexIndex)
 {
-	var value = isMultiplexed() ? refLink->getLinkedValue(multiplexIndex) : reference->getValue();
-
-	if (currentFunctionId == equalsId)				return sourceParam->floatValue() == (float)value;
-	else if (currentFunctionId == differentId)		return sourceParam->floatValue() != (float)value;
-	else if (currentFunctionId == greaterId)		return sourceParam->floatValue() > (float)value;
-	else if (currentFunctionId == lessId)			return sourceParam->floatValue() < (float)value;
-	else if (currentFunctionId == greaterOrEqualId)	return sourceParam->floatValue() >= (float)value;
-	else if (currentFunctionId == lessOrEqualId)	return sourceParam->floatValue() <= (float)value;
-	else if (currentFunctionId == moduloEqualId)	return (float)value[0] == 0 ? false : fmodf(sourceParam->floatValue(), (float)value[0]) == (float)value[1];
-	else if (currentFunctionId == moduloGreaterId)	return (float)value[0] == 0 ? false : fmodf(sourceParam->floatValue(), (float)value[0]) > (float)value[1];
-	else if (currentFunctionId == moduloLessId)		return (float)value[0] == 0 ? false : fmodf(sourceParam->floatValue(), (float)value[0]) < (float)value[1];
-	else if (currentFunctionId == floorEqualId)		return (float)value[0] == 0 ? false : floorf(sourceParam->floatValue() / (float)value[0]) == (float)value[1];
-	else if (currentFunctionId == floorGreaterId)	return (float)value[0] == 0 ? false : floorf(sourceParam->floatValue() / (float)value[0]) >(float)value[1];
-	else if (currentFunctionId == floorLessId)		return (float)value[0] == 0 ? false : floorf(sourceParam->floatValue() / (float)value[0]) < (float)value[1];
-	else if (currentFunctionId == inRangeId)		return sourceParam->floatValue() >= (float)value[0] && sourceParam->floatValue() <= (float)value[1];
-	else if (currentFunctionId == diffGreaterId || currentFunctionId == diffLessId)
+	if (compareFunc == nullptr) return false;
+
+	const float sourceValue = sourceParam->floatValue();
+	const Point<float> ref = getNumericReference(multiplexIndex);
+
+	if (isDiffFunction)
 	{
-		prevValues.ensureStorageAllocated(multiplexIndex + 1);
-		float diff = fabsf(sourceParam->floatValue() - prevValues[multiplexIndex]);
-		bool result = currentFunctionId == diffGreaterId ? diff > (float)value : diff < (float)value;
-		prevValues.set(multiplexIndex, sourceParam->floatValue());
-		return result;
+		if (multiplexIndex >= prevValues.size()) prevValues.resize(multiplexIndex + 1);
+		float diff = fabsf(sourceValue - prevValues[multiplexIndex]);
+		prevValues.set(multiplexIndex, sourceValue);
+		return compareFunc(diff, ref.x, ref.y);
 	}
-	return false;
+
+	return compareFunc(sourceValue, ref.x, ref.y);
 }
\ No newline at end of file
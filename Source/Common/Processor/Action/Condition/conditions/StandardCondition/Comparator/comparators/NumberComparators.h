@@ -39,6 +39,19 @@ public:
 	var sourceRange;
 	Array<float> prevValues;
 
+	//Resolved when the function changes, ref2 is only used by 2-values references (modulo, floor, range)
+	typedef bool (*CompareFunc)(float value, float ref1, float ref2);
+	CompareFunc compareFunc;
+	bool isDiffFunction;
+
+	//Numeric reference per multiplex index, x and y hold ref1 and ref2
+	Array<Point<float>> numRefCache;
+	Array<bool> numRefCacheValid;
+
+	void updateCompareFunc();
+	Point<float> getNumericReference(int multiplexIndex);
+	void invalidateReferenceCache(int multiplexIndex = -1) override;
+
 	virtual void compareFunctionChanged() override;
 	virtual void setupReferenceParam();
 	
@@ -10,7 +10,8 @@
 
 Point2DComparator::Point2DComparator(Parameter* sourceParam, Multiplex* multiplex) :
 	BaseComparator(multiplex),
-	sourceParam(sourceParam)
+	sourceParam(sourceParam),
+	compareFunc(nullptr)
 {
 	addCompareOption("=", equalsId);
 	addCompareOption("Magnitude >", magnGreaterId);
@@ -22,6 +23,7 @@ Point2DComparator::Point2DComparator(Parameter* sourceParam, Multiplex* multiple
 	addCompareOption("Change", changeId);
 
 	updateReferenceParam();
+	compareFunctionChanged();
 }
 
 Point2DComparator::~Point2DComparator()
@@ -92,17 +94,20 @@ void Point2DComparator::updateReferenceParam()
 	setReferenceParam(newRef);
 }
 
+void Point2DComparator::compareFunctionChanged()
+{
+	if (currentFunctionId == equalsId)				compareFunc = [](Point<float> p, const var& r) { return p == Point<float>(r[0], r[1]); };
+	else if (currentFunctionId == magnGreaterId)	compareFunc = [](Point<float> p, const var& r) { return p.getDistanceFromOrigin() > (float)r; };
+	else if (currentFunctionId == magnLessId)		compareFunc = [](Point<float> p, const var& r) { return p.getDistanceFromOrigin() < (float)r; };
+	else if (currentFunctionId == xGreaterId)		compareFunc = [](Point<float> p, const var& r) { return p.x > (float)r; };
+	else if (currentFunctionId == xLessId)			compareFunc = [](Point<float> p, const var& r) { return p.x < (float)r; };
+	else if (currentFunctionId == yGreaterId)		compareFunc = [](Point<float> p, const var& r) { return p.y > (float)r; };
+	else if (currentFunctionId == yLessId)			compareFunc = [](Point<float> p, const var& r) { return p.y < (float)r; };
+	else compareFunc = nullptr;
+}
+
 bool Point2DComparator::compareInternal(Parameter* sourceParam, int multiplexIndex)
 {
-	Point<float> p = ((Point2DParameter*)sourceParam)->getPoint();
-	var value = isMultiplexed() ? refLink->getLinkedValue(multiplexIndex) : reference->getValue();
-
-	if (currentFunctionId == equalsId)				return p == Point<float>(value[0], value[1]);
-	else if (currentFunctionId == magnGreaterId)	return p.getDistanceFromOrigin() > (float)value;
-	else if (currentFunctionId == magnLessId)		return p.getDistanceFromOrigin() < (float)value;
-	else if (currentFunctionId == xGreaterId)	return p.x > (float)value;
-	else if (currentFunctionId == xLessId)		return p.x < (float)value;
-	else if (currentFunctionId == yGreaterId)	return p.y > (float)value;
-	else if (currentFunctionId == yLessId)		return p.y < (float)value;
-	return false;
+	if (compareFunc == nullptr) return false;
+	return compareFunc(((Point2DParameter*)sourceParam)->getPoint(), getReferenceValue(multiplexIndex));
 }
\ No newline at end of file
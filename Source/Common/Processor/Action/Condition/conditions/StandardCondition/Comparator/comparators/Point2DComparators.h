@@ -28,6 +28,11 @@ public:
 
 	Parameter* sourceParam;
 
+	typedef bool (*CompareFunc)(Point<float> p, const var& ref);
+	CompareFunc compareFunc;
+
+	virtual void compareFunctionChanged() override;
+
 	void onContainerParameterChanged(Parameter* p) override;
 	void updateReferenceParam();
 
@@ -10,7 +10,8 @@
 
 Point3DComparator::Point3DComparator(Parameter* sourceParam, Multiplex* multiplex) :
 	BaseComparator(multiplex),
-	sourceParam(sourceParam)
+	sourceParam(sourceParam),
+	compareFunc(nullptr)
 {
 
 
@@ -25,6 +26,7 @@ Point3DComparator::Point3DComparator(Parameter* sourceParam, Multiplex* multiple
 	addCompareOption("Z <", zLessId);
 	addCompareOption("Change", changeId);
 	updateReferenceParam();
+	compareFunctionChanged();
 }
 
 Point3DComparator::~Point3DComparator()
@@ -94,20 +96,22 @@ void Point3DComparator::updateReferenceParam()
 	setReferenceParam(newRef);
 }
 
+void Point3DComparator::compareFunctionChanged()
+{
+	if (currentFunctionId == equalsId)				compareFunc = [](Vector3D<float> p, const var& r) { return p.x == (float)r[0] && p.y == (float)r[1] && p.z == (float)r[2]; };
+	else if (currentFunctionId == magnGreaterId)	compareFunc = [](Vector3D<float> p, const var& r) { return p.length() > (float)r; };
+	else if (currentFunctionId == magnLessId)		compareFunc = [](Vector3D<float> p, const var& r) { return p.length() < (float)r; };
+	else if (currentFunctionId == xGreaterId)		compareFunc = [](Vector3D<float> p, const var& r) { return p.x > (float)r; };
+	else if (currentFunctionId == xLessId)			compareFunc = [](Vector3D<float> p, const var& r) { return p.x < (float)r; };
+	else if (currentFunctionId == yGreaterId)		compareFunc = [](Vector3D<float> p, const var& r) { return p.y > (float)r; };
+	else if (currentFunctionId == yLessId)			compareFunc = [](Vector3D<float> p, const var& r) { return p.y < (float)r; };
+	else if (currentFunctionId == zGreaterId)		compareFunc = [](Vector3D<float> p, const var& r) { return p.z > (float)r; };
+	else if (currentFunctionId == zLessId)			compareFunc = [](Vector3D<float> p, const var& r) { return p.z < (float)r; };
+	else compareFunc = nullptr;
+}
+
 bool Point3DComparator::compareInternal(Parameter* sourceParam, int multiplexIndex)
 {
-	Vector3D<float> p = ((Point3DParameter*)sourceParam)->getVector();
-	var value = isMultiplexed() ? refLink->getLinkedValue(multiplexIndex) : reference->getValue();
-
-	if (currentFunctionId == equalsId)				return p.x == (float)value[0] && p.y == (float)value[1] && p.z == (float)value[2];
-	else if (currentFunctionId == magnGreaterId)	return p.length() > (float)value;
-	else if (currentFunctionId == magnLessId)		return p.length() < (float)value;
-	else if (currentFunctionId == xGreaterId)	return p.x > (float)value;
-	else if (currentFunctionId == xLessId)		return p.x < (float)value;
-	else if (currentFunctionId == yGreaterId)	return p.y > (float)value;
-	else if (currentFunctionId == yLessId)		return p.y < (float)value;
-	else if (currentFunctionId == zGreaterId)	return p.z > (float)value;
-	else if (currentFunctionId == zLessId)		return p.z < (float)value; 
-	
-	return false;
+	if (compareFunc == nullptr) return false;
+	return compareFunc(((Point3DParameter*)sourceParam)->getVector(), getReferenceValue(multiplexIndex));
 }
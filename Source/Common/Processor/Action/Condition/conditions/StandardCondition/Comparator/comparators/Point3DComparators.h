@@ -29,6 +29,11 @@ public:
 	const Identifier changeId = "ch";
 	Parameter* sourceParam;
 
+	typedef bool (*CompareFunc)(Vector3D<float> p, const var& ref);
+	CompareFunc compareFunc;
+
+	virtual void compareFunctionChanged() override;
+
 	void onContainerParameterChanged(Parameter* p) override;
 	void updateReferenceParam();
 
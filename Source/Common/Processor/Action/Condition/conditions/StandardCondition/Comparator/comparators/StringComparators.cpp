@@ -9,7 +9,8 @@
 */
 
 StringComparator::StringComparator(Parameter *sourceParam, Multiplex* multiplex) :
-	BaseComparator(multiplex)
+	BaseComparator(multiplex),
+	compareFunc(nullptr)
 {
 	setReferenceParam(new StringParameter("Reference", "Comparison Reference to check against source value", sourceParam->stringValue()));
 	reference->setValue(sourceParam->stringValue(), false, true, true);
@@ -20,20 +21,27 @@ StringComparator::StringComparator(Parameter *sourceParam, Multiplex* multiplex)
 	addCompareOption("Starts with", startsWith);
 	addCompareOption("Ends with", endsWidth);
 	addCompareOption("Change", changeId);
+
+	compareFunctionChanged();
 }
 
 StringComparator::~StringComparator()
 {
 }
 
+void StringComparator::compareFunctionChanged()
+{
+	if (currentFunctionId == equalsId)				compareFunc = [](const String& v, const String& r) { return v == r; };
+	else if (currentFunctionId == differentId)		compareFunc = [](const String& v, const String& r) { return v != r; };
+	else if (currentFunctionId == containsId)		compareFunc = [](const String& v, const String& r) { return v.contains(r); };
+	else if (currentFunctionId == startsWith)		compareFunc = [](const String& v, const String& r) { return v.startsWith(r); };
+	else if (currentFunctionId == endsWidth)		compareFunc = [](const String& v, const String& r) { return v.endsWith(r); };
+	else compareFunc = nullptr;
+}
+
 bool StringComparator::compareInternal(Parameter* sourceParam, int multiplexIndex)
 {
-	String value = isMultiplexed() ? refLink->getLinkedValue(multiplexIndex).toString() : reference->stringValue();
-
-	if (currentFunctionId == equalsId)				return sourceParam->stringValue() == value;
-	else if (currentFunctionId == differentId)		return sourceParam->stringValue() != value;
-	else if (currentFunctionId == containsId)		return sourceParam->stringValue().contains(value);
-	else if (currentFunctionId == startsWith)		return sourceParam->stringValue().startsWith(value);
-	else if (currentFunctionId == endsWidth)		return sourceParam->stringValue().endsWith(value);
-	return false;
+	if (compareFunc == nullptr) return false;
+	String value = isMultiplexed() ? getReferenceValue(multiplexIndex).toString() : reference->stringValue();
+	return compareFunc(sourceParam->stringValue(), value);
 }
\ No newline at end of file
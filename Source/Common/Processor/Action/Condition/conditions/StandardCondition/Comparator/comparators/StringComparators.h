@@ -23,5 +23,9 @@ public:
 	const Identifier startsWith = "startsWith";
 	const Identifier endsWidth = "endsWidth";
 
+	typedef bool (*CompareFunc)(const String& value, const String& ref);
+	CompareFunc compareFunc;
+
+	virtual void compareFunctionChanged() override;
 	virtual bool compareInternal(Parameter* sourceParam, int multiplexIndex) override;
 };
\ No newline at end of file
@@ -90,12 +90,14 @@ InputValueMultiplexList::InputValueMultiplexList(var params) :
 
 InputValueMultiplexList::~InputValueMultiplexList()
 {
-	for (auto& c : inputControllables)
+	Array<Controllable*> sources;
 	{
-		if (c == nullptr || c.wasObjectDeleted()) continue;
-		if (c->type == c->TRIGGER) ((Trigger*)c.get())->removeTriggerListener(this);
-		else((Parameter*)c.get())->removeParameterListener(this);
+		const ScopedWriteLock lock(inputIndicesLock);
+		for (HashMap<Controllable*, Array<int>>::Iterator it(inputIndicesMap); it.next();) sources.add(it.getKey());
+		inputIndicesMap.clear();
 	}
+
+	for (auto& c : sources) unregisterInputControllable(c);
 }
 
 void InputValueMultiplexList::updateControllablesSetup()
@@ -103,14 +105,12 @@ void InputValueMultiplexList::updateControllablesSetup()
 	while (list.size() > listSize)
 	{
 		int index = list.size() - 1;
+		setInputControllableAt(index, nullptr);
+		inputControllables.removeLast();
+
 		Controllable* c = list[index];
 		list.removeAllInstancesOf(c);
 		removeControllable(c);
-		if (Controllable* c = inputControllables[index])
-		{
-			if (c->type == c->TRIGGER) ((Trigger*)c)->removeTriggerListener(this);
-			else((Parameter*)c)->removeParameterListener(this);
-		}
 	}
 
 	while (list.size() < listSize)
@@ -125,25 +125,86 @@ void InputValueMultiplexList::updateControllablesSetup()
 	}
 }
 
-void InputValueMultiplexList::onContainerParameterChangedInternal(Parameter* p)
+void InputValueMultiplexList::setInputControllableAt(int index, Controllable* c)
 {
-	int index = list.indexOf(p);
-	if (index != -1)
+	Controllable* oldC = inputControllables[index];
+	bool oldIsUnused = false;
+	bool isNew = false;
+
 	{
-		if (Controllable* c = inputControllables[index])
+		//listeners are added and removed outside of the lock, the sources may be calling them at the same time
+		const ScopedWriteLock lock(inputIndicesLock);
+		if (oldC != nullptr && inputIndicesMap.contains(oldC))
 		{
-			if (c->type == c->TRIGGER) ((Trigger*)c)->removeTriggerListener(this);
-			else((Parameter*)c)->removeParameterListener(this);
+			Array<int>& indices = inputIndicesMap.getReference(oldC);
+			indices.removeAllInstancesOf(index);
+
+			if (indices.isEmpty())
+			{
+				inputIndicesMap.remove(oldC);
+				oldIsUnused = true;
+			}
 		}
 
-		inputControllables.set(index, nullptr);
-
-		if (Controllable* c = ((TargetParameter*)p)->target)
+		if (c != nullptr)
 		{
-			if (c->type == c->TRIGGER) ((Trigger*)c)->addTriggerListener(this);
-			else((Parameter*)c)->addParameterListener(this);
-			inputControllables.set(index, c);
+			isNew = !inputIndicesMap.contains(c);
+			inputIndicesMap.getReference(c).addUsingDefaultSort(index);
+		}
+	}
+
+	inputControllables.set(index, c);
+
+	if (oldIsUnused) unregisterInputControllable(oldC);
+	if (isNew) registerInputControllable(c);
+}
+
+Array<int> InputValueMultiplexList::getInputIndices(Controllable* c)
+{
+	const ScopedReadLock lock(inputIndicesLock);
+	return inputIndicesMap.contains(c) ? inputIndicesMap.getReference(c) : Array<int>();
+}
+
+void InputValueMultiplexList::registerInputControllable(Controllable* c)
+{
+	if (c->type == c->TRIGGER) ((Trigger*)c)->addTriggerListener(this);
+	else((Parameter*)c)->addParameterListener(this);
+	c->addInspectableListener(this);
+}
+
+void InputValueMultiplexList::unregisterInputControllable(Controllable* c)
+{
+	if (c->type == c->TRIGGER) ((Trigger*)c)->removeTriggerListener(this);
+	else((Parameter*)c)->removeParameterListener(this);
+	c->removeInspectableListener(this);
+}
+
+void InputValueMultiplexList::inspectableDestroyed(Inspectable* i)
+{
+	//forget a deleted source, another controllable allocated at the same address must not inherit its indices
+	const ScopedWriteLock lock(inputIndicesLock);
+	Controllable* deleted = nullptr;
+	for (HashMap<Controllable*, Array<int>>::Iterator it(inputIndicesMap); it.next();)
+	{
+		if ((Inspectable*)it.getKey() != i) continue;
+		deleted = it.getKey();
+		for (auto& index : it.getValue()) inputControllables.set(index, nullptr);
+		break;
+	}
 
+	if (deleted != nullptr) inputIndicesMap.remove(deleted);
+}
+
+void InputValueMultiplexList::onContainerParameterChangedInternal(Parameter* p)
+{
+	int index = list.indexOf(p);
+	if (index != -1)
+	{
+		Controllable* c = ((TargetParameter*)p)->target;
+		setInputControllableAt(index, c);
+
+		if (c != nullptr)
+		{
 			listListeners.call(&MultiplexListListener::listReferenceUpdated);
 			notifyItemUpdated(index);
 		}
@@ -152,17 +213,18 @@ void InputValueMultiplexList::onContainerParameterChangedInternal(Parameter* p)
 
 void InputValueMultiplexList::onExternalParameterRangeChanged(Parameter* p)
 {
-	if (inputControllables.indexOf(p) != -1) listListeners.call(&MultiplexListListener::listReferenceUpdated);
+	if (!getInputIndices(p).isEmpty()) listListeners.call(&MultiplexListListener::listReferenceUpdated);
 }
 
 void InputValueMultiplexList::onExternalParameterValueChanged(Parameter* p)
 {
-	notifyItemUpdated(inputControllables.indexOf(p));
+	//a copy, item listeners may change the sources
+	for (auto& i : getInputIndices(p)) notifyItemUpdated(i);
 }
 
 void InputValueMultiplexList::onExternalTriggerTriggered(Trigger* t)
 {
-	notifyItemUpdated(inputControllables.indexOf(t));
+	for (auto& i : getInputIndices(t)) notifyItemUpdated(i);
 }
 
 void InputValueMultiplexList::fillFromExpression(const String& s)
@@ -98,16 +98,27 @@ public:
 };
 
 class InputValueMultiplexList :
-	public BaseMultiplexList
+	public BaseMultiplexList,
+	public Inspectable::InspectableListener
 {
 public:
 	InputValueMultiplexList(var params = var());
 	~InputValueMultiplexList();
 
 	Array<WeakReference<Controllable>> inputControllables;
+	HashMap<Controllable*, Array<int>> inputIndicesMap; //reverse lookup, a source can be set at multiple indices
+	ReadWriteLock inputIndicesLock; //written on the message thread, read from the threads the sources change on
+
+	Array<int> getInputIndices(Controllable* c);
 
 	void updateControllablesSetup() override;
 
+	void setInputControllableAt(int index, Controllable* c);
+	void registerInputControllable(Controllable* c);
+	void unregisterInputControllable(Controllable* c);
+
+	void inspectableDestroyed(Inspectable* i) override;
+
 	void onContainerParameterChangedInternal(Parameter* p) override;
 
 	void onExternalParameterRangeChanged(Parameter* p) override;
@@ -23,6 +23,7 @@
 #include "Action/Action.cpp"
 #include "Action/Condition/Condition.cpp"
 #include "Action/Condition/ConditionManager.cpp"
+#include "Action/Condition/ConditionValidationScheduler.cpp"
 
 #include "Action/Condition/conditions/ActivationCondition/ActivationCondition.cpp"
 #include "Action/Condition/conditions/ConditionGroup/ConditionGroup.cpp"
@@ -25,6 +25,7 @@
 #include "Action/Condition/Condition.h"
 #include "Action/Condition/ConditionManagerListener.h"
 #include "Action/Condition/ConditionManager.h"
+#include "Action/Condition/ConditionValidationScheduler.h"
 
 #include "Action/Condition/conditions/ActivationCondition/ActivationCondition.h"
 #include "Action/Condition/conditions/ConditionGroup/ConditionGroup.h"
@@ -0,0 +1,422 @@
+/*
+  ==============================================================================
+
+	ProjectSnapshot.cpp
+	Created: 19 Oct 2026 2:15:19am
+	Author:  agent
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+
+namespace ProjectSnapshot
+{
+	class SectionWriter
+	{
+	public:
+		MemoryOutputStream body;
+		StringArray strings;
+		HashMap<String, int> stringIndices;
+
+		static void writeVarInt(OutputStream& os, uint64 v)
+		{
+			while (v >= 0x80)
+			{
+				os.writeByte((char)(v | 0x80));
+				v >>= 7;
+			}
+			os.writeByte((char)v);
+		}
+
+		static void writeSignedVarInt(OutputStream& os, int64 v)
+		{
+			writeVarInt(os, ((uint64)v << 1) ^ (uint64)(v >> 63));
+		}
+
+		int intern(const String& s)
+		{
+			if (stringIndices.contains(s)) return stringIndices[s];
+			int index = strings.size();
+			strings.add(s);
+			stringIndices.set(s, index);
+			return index;
+		}
+
+		static ValueType getPackedArrayType(const Array<var>& a)
+		{
+			if (a.size() < 2) return ARRAY_TYPE;
+
+			bool allInts = true;
+			bool allDoubles = true;
+			bool allFloats = true;
+			for (auto& v : a)
+			{
+				if (!v.isInt()) allInts = false;
+				if (!v.isDouble()) allDoubles = allFloats = false;
+				else if ((double)(float)(double)v != (double)v) allFloats = false;
+				if (!allInts && !allDoubles) return ARRAY_TYPE;
+			}
+
+			if (allInts) return INT_ARRAY_TYPE;
+			return allFloats ? FLOAT_ARRAY_TYPE : DOUBLE_ARRAY_TYPE;
+		}
+
+		void writeValue(const var& v)
+		{
+			if (v.isVoid()) body.writeByte(VOID_TYPE);
+			else if (v.isUndefined()) body.writeByte(UNDEFINED_TYPE);
+			else if (v.isBool()) body.writeByte((bool)v ? TRUE_TYPE : FALSE_TYPE);
+			else if (v.isInt())
+			{
+				body.writeByte(INT_TYPE);
+				writeSignedVarInt(body, (int)v);
+			}
+			else if (v.isInt64())
+			{
+				body.writeByte(INT64_TYPE);
+				writeSignedVarInt(body, (int64)v);
+			}
+			else if (v.isDouble())
+			{
+				body.writeByte(DOUBLE_TYPE);
+				body.writeDouble((double)v);
+			}
+			else if (v.isString())
+			{
+				body.writeByte(STRING_TYPE);
+				writeVarInt(body, (uint64)intern(v.toString()));
+			}
+			else if (MemoryBlock* b = v.getBinaryData())
+			{
+				body.writeByte(BINARY_TYPE);
+				writeVarInt(body, b->getSize());
+				body << *b;
+			}
+			else if (Array<var>* a = v.getArray())
+			{
+				ValueType type = getPackedArrayType(*a);
+				body.writeByte((char)type);
+				writeVarInt(body, (uint64)a->size());
+
+				switch (type)
+				{
+				case INT_ARRAY_TYPE: for (auto& i : *a) writeSignedVarInt(body, (int)i); break;
+				case FLOAT_ARRAY_TYPE: for (auto& i : *a) body.writeFloat((float)(double)i); break;
+				case DOUBLE_ARRAY_TYPE: for (auto& i : *a) body.writeDouble((double)i); break;
+				default: for (auto& i : *a) writeValue(i); break;
+				}
+			}
+			else if (DynamicObject* o = v.getDynamicObject())
+			{
+				NamedValueSet& props = o->getProperties();
+				body.writeByte(OBJECT_TYPE);
+				writeVarInt(body, (uint64)props.size());
+				for (auto& p : props)
+				{
+					writeVarInt(body, (uint64)intern(p.name.toString()));
+					writeValue(p.value);
+				}
+			}
+			else body.writeByte(VOID_TYPE); //methods and native objects have no json form either
+		}
+	};
+
+	class SectionReader
+	{
+	public:
+		SectionReader(const void* data, size_t size) :
+			data((const uint8*)data),
+			size(size),
+			pos(0),
+			failed(false)
+		{
+		}
+
+		const uint8* data;
+		size_t size;
+		size_t pos;
+		bool failed;
+
+		StringArray strings;
+		Array<Identifier> identifiers; //created on first use as a key, most strings are only values
+
+		bool canRead(uint64 numBytes)
+		{
+			if (numBytes > size - pos) failed = true;
+			return !failed;
+		}
+
+		uint64 readVarInt()
+		{
+			uint64 result = 0;
+			for (int shift = 0; shift < 64 && canRead(1); shift += 7)
+			{
+				uint8 b = data[pos++];
+				result |= (uint64)(b & 0x7F) << shift;
+				if ((b & 0x80) == 0) return result;
+			}
+
+			failed = true;
+			return 0;
+		}
+
+		int64 readSignedVarInt()
+		{
+			uint64 v = readVarInt();
+			return (int64)(v >> 1) ^ -(int64)(v & 1);
+		}
+
+		float readFloat()
+		{
+			if (!canRead(4)) return 0;
+			uint32 bits = ByteOrder::littleEndianInt(data + pos);
+			float f;
+			memcpy(&f, &bits, 4);
+			pos += 4;
+			return f;
+		}
+
+		double readDouble()
+		{
+			if (!canRead(8)) return 0;
+			uint64 bits = ByteOrder::littleEndianInt64(data + pos);
+			double d;
+			memcpy(&d, &bits, 8);
+			pos += 8;
+			return d;
+		}
+
+		bool readStrings()
+		{
+			uint64 numStrings = readVarInt();
+			if (!canRead(numStrings)) return false;
+
+			strings.ensureStorageAllocated((int)numStrings);
+			for (uint64 i = 0; i < numStrings && !failed; i++)
+			{
+				uint64 length = readVarInt();
+				if (!canRead(length)) break;
+				strings.add(String::fromUTF8((const char*)data + pos, (int)length));
+				pos += (size_t)length;
+			}
+
+			identifiers.insertMultiple(0, Identifier(), strings.size());
+			return !failed;
+		}
+
+		int readStringIndex()
+		{
+			uint64 index = readVarInt();
+			if (index >= (uint64)strings.size()) failed = true;
+			return failed ? -1 : (int)index;
+		}
+
+		var readValue(int depth)
+		{
+			if (depth > 512 || !canRead(1))
+			{
+				failed = true;
+				return var();
+			}
+
+			ValueType type = (ValueType)data[pos++];
+			switch (type)
+			{
+			case VOID_TYPE: return var();
+			case UNDEFINED_TYPE: return var::undefined();
+			case FALSE_TYPE: return false;
+			case TRUE_TYPE: return true;
+			case INT_TYPE: return (int)readSignedVarInt();
+			case INT64_TYPE: return readSignedVarInt();
+			case DOUBLE_TYPE: return readDouble();
+
+			case STRING_TYPE:
+			{
+				int index = readStringIndex();
+				return index >= 0 ? var(strings[index]) : var();
+			}
+
+			case BINARY_TYPE:
+			{
+				uint64 length = readVarInt();
+				if (!canRead(length)) return var();
+				var result(data + pos, (size_t)length);
+				pos += (size_t)length;
+				return result;
+			}
+
+			case ARRAY_TYPE:
+			case INT_ARRAY_TYPE:
+			case FLOAT_ARRAY_TYPE:
+			case DOUBLE_ARRAY_TYPE:
+			{
+				uint64 count = readVarInt();
+				if (!canRead(count)) return var(); //every item takes at least one byte
+
+				var result = Array<var>();
+				Array<var>* a = result.getArray();
+				a->ensureStorageAllocated((int)count);
+
+				for (uint64 i = 0; i < count && !failed; i++)
+				{
+					switch (type)
+					{
+					case INT_ARRAY_TYPE: a->add((int)readSignedVarInt()); break;
+					case FLOAT_ARRAY_TYPE: a->add((double)readFloat()); break;
+					case DOUBLE_ARRAY_TYPE: a->add(readDouble()); break;
+					default: a->add(readValue(depth + 1)); break;
+					}
+				}
+
+				return result;
+			}
+
+			case OBJECT_TYPE:
+			{
+				uint64 count = readVarInt();
+				if (!canRead(count)) return var();
+
+				DynamicObject::Ptr o = new DynamicObject();
+				NamedValueSet& props = o->getProperties();
+				for (uint64 i = 0; i < count && !failed; i++)
+				{
+					int index = readStringIndex();
+					if (index < 0) break;
+					if (identifiers[index].isNull()) identifiers.set(index, Identifier(strings[index]));
+					props.set(identifiers[index], readValue(depth + 1));
+				}
+
+				return var(o.get());
+			}
+
+			default:
+				failed = true;
+				return var();
+			}
+		}
+	};
+
+	void writeSection(const var& data, MemoryBlock& dest)
+	{
+		SectionWriter w;
+		w.writeValue(data);
+
+		MemoryOutputStream os(dest, false);
+		SectionWriter::writeVarInt(os, (uint64)w.strings.size());
+		for (auto& s : w.strings)
+		{
+			size_t length = s.getNumBytesAsUTF8();
+			SectionWriter::writeVarInt(os, length);
+			os.write(s.toRawUTF8(), length);
+		}
+
+		os.write(w.body.getData(), w.body.getDataSize());
+	}
+
+	bool readSection(const void* data, size_t size, var& result)
+	{
+		SectionReader r(data, size);
+		if (!r.readStrings()) return false;
+		result = r.readValue(0);
+		return !r.failed;
+	}
+
+	bool writeFile(const File& file, const OwnedArray<Section>& sections)
+	{
+		//write next to the target and swap, a crash during save never leaves a half written snapshot
+		TemporaryFile temp(file);
+		{
+			FileOutputStream os(temp.getFile());
+			if (os.failedToOpen()) return false;
+
+			os.write(magic, 4);
+			os.writeShort((short)version);
+			os.writeShort((short)sections.size());
+
+			for (auto& s : sections)
+			{
+				os.writeString(s->name);
+				os.writeInt((int)s->data.getSize());
+				os << s->data;
+			}
+
+			os.flush();
+			if (os.getStatus().failed()) return false;
+		}
+
+		return temp.overwriteTargetFileWithTemporary();
+	}
+
+	var readFile(const File& file)
+	{
+		MemoryBlock fileData;
+		if (!file.loadFileAsData(fileData) || fileData.getSize() < 8 || memcmp(fileData.getData(), magic, 4) != 0)
+		{
+			LOGERROR(file.getFileName() << " is not a project snapshot");
+			return var();
+		}
+
+		MemoryInputStream is(fileData, false);
+		is.skipNextBytes(4);
+
+		int fileVersion = is.readShort();
+		if (fileVersion > version)
+		{
+			LOGERROR(file.getFileName() << " was written by a newer version (snapshot version " << fileVersion << ")");
+			return var();
+		}
+
+		int numSections = (uint16)is.readShort();
+
+		var data(new DynamicObject());
+		for (int i = 0; i < numSections; i++)
+		{
+			String name = is.readString();
+			int64 size = (uint32)is.readInt();
+
+			var sectionData;
+			if (size > is.getNumBytesRemaining() || !readSection((const uint8*)fileData.getData() + is.getPosition(), (size_t)size, sectionData))
+			{
+				LOGERROR(file.getFileName() << " is corrupted (section " << name << ")");
+				return var();
+			}
+
+			is.skipNextBytes(size);
+
+			if (name == engineSectionName)
+			{
+				if (DynamicObject* o = sectionData.getDynamicObject())
+				{
+					for (auto& p : o->getProperties()) data.getDynamicObject()->setProperty(p.name, p.value);
+				}
+			}
+			else data.getDynamicObject()->setProperty(name, sectionData);
+		}
+
+		return data;
+	}
+
+	bool convertToJSON(const File& snapshotFile, const File& jsonFile)
+	{
+		var data = readFile(snapshotFile);
+		if (!data.isObject()) return false;
+		return jsonFile.replaceWithText(JSON::toString(data));
+	}
+
+	bool convertFromJSON(const File& jsonFile, const File& snapshotFile)
+	{
+		var data = JSON::parse(jsonFile);
+		if (!data.isObject())
+		{
+			LOGERROR(jsonFile.getFileName() << " is not a valid project file");
+			return false;
+		}
+
+		OwnedArray<Section> sections;
+		Section* s = sections.add(new Section());
+		s->name = engineSectionName;
+		writeSection(data, s->data);
+		return writeFile(snapshotFile, sections);
+	}
+}
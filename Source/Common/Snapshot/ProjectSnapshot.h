@@ -0,0 +1,41 @@
+/*
+  ==============================================================================
+
+	ProjectSnapshot.h
+	Created: 19 Oct 2026 2:15:19am
+	Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//Binary project format, converts losslessly to and from the .noisette json. All values little endian
+//File : "CSNP", uint16 version, uint16 section count, then for each section : name, uint32 size, section data
+//Section : string table, then the root value. Every identifier and string is written once per section,
+//and arrays of plain numbers (automation keys, preset values, patch data) are packed as typed arrays.
+//Sections are self-contained, so an unchanged manager can be written again from its cached bytes
+namespace ProjectSnapshot
+{
+	enum ValueType { VOID_TYPE, UNDEFINED_TYPE, FALSE_TYPE, TRUE_TYPE, INT_TYPE, INT64_TYPE, DOUBLE_TYPE, STRING_TYPE, ARRAY_TYPE, OBJECT_TYPE, BINARY_TYPE, INT_ARRAY_TYPE, FLOAT_ARRAY_TYPE, DOUBLE_ARRAY_TYPE };
+
+	const char magic[4] = { 'C', 'S', 'N', 'P' };
+	const int version = 1;
+	const char* const engineSectionName = "engine"; //its properties are the root of the project data, other sections are added to it by name
+	const char* const fileExtension = ".noisnap";
+
+	struct Section
+	{
+		String name;
+		MemoryBlock data;
+	};
+
+	void writeSection(const var& data, MemoryBlock& dest);
+	bool readSection(const void* data, size_t size, var& result);
+
+	bool writeFile(const File& file, const OwnedArray<Section>& sections);
+	var readFile(const File& file);
+
+	bool convertToJSON(const File& snapshotFile, const File& jsonFile);
+	bool convertFromJSON(const File& jsonFile, const File& snapshotFile);
+}
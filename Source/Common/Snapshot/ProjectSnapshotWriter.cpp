@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+	ProjectSnapshotWriter.cpp
+	Created: 19 Oct 2026 2:15:19am
+	Author:  agent
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+
+ProjectSnapshotWriter::ProjectSnapshotWriter() :
+	Thread("Project Snapshot")
+{
+	startThread();
+	startTimer(1000);
+}
+
+ProjectSnapshotWriter::~ProjectSnapshotWriter()
+{
+	stopTimer();
+	stopThread(5000);
+}
+
+void ProjectSnapshotWriter::save(const File& file, const Array<PendingSection>& sections)
+{
+	GenericScopedLock lock(pendingLock);
+	pendingFile = file;
+
+	for (auto& s : sections)
+	{
+		//a section still waiting to be encoded keeps its data if it has not changed since
+		int index = -1;
+		for (int i = 0; i < pending.size(); i++) if (pending.getReference(i).name == s.name) index = i;
+
+		if (index == -1) pending.add(s);
+		else if (!s.data.isVoid()) pending.getReference(index).data = s.data;
+	}
+
+	notify();
+}
+
+ProjectSnapshot::Section* ProjectSnapshotWriter::getCachedSection(const String& name)
+{
+	for (auto& s : cachedSections) if (s->name == name) return s;
+
+	ProjectSnapshot::Section* s = cachedSections.add(new ProjectSnapshot::Section());
+	s->name = name;
+	return s;
+}
+
+void ProjectSnapshotWriter::run()
+{
+	while (!threadShouldExit())
+	{
+		wait(-1);
+		if (threadShouldExit()) return;
+
+		File file;
+		Array<PendingSection> sections;
+		{
+			GenericScopedLock lock(pendingLock);
+			if (pendingFile == File()) continue;
+			file = pendingFile;
+			pendingFile = File();
+			sections.swapWith(pending);
+		}
+
+		double startMillis = Time::getMillisecondCounterHiRes();
+
+		int numEncoded = 0;
+		for (auto& s : sections)
+		{
+			if (s.data.isVoid()) continue;
+			ProjectSnapshot::Section* cached = getCachedSection(s.name);
+			cached->data.reset();
+			ProjectSnapshot::writeSection(s.data, cached->data);
+			numEncoded++;
+		}
+
+		if (!ProjectSnapshot::writeFile(file, cachedSections))
+		{
+			LOGERROR("Could not write snapshot to " << file.getFullPathName());
+			continue;
+		}
+
+		NLOG("Snapshot", "Saved " << file.getFileName() << " (" << numEncoded << "/" << cachedSections.size() << " sections encoded, " << File::descriptionOfSizeInBytes(file.getSize()) << ") in " << String(Time::getMillisecondCounterHiRes() - startMillis, 0) << "ms");
+	}
+}
+
+void ProjectSnapshotWriter::timerCallback()
+{
+	if (onAutoSnapshot != nullptr) onAutoSnapshot();
+}
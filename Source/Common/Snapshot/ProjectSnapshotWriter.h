@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+	ProjectSnapshotWriter.h
+	Created: 19 Oct 2026 2:15:19am
+	Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//Encodes and writes snapshots from its own thread, so the message thread only collects the data of what changed.
+//Each section keeps its last encoded bytes, an unchanged manager is written again without being serialized
+class ProjectSnapshotWriter :
+	public Thread,
+	public Timer
+{
+public:
+	ProjectSnapshotWriter();
+	~ProjectSnapshotWriter();
+
+	struct PendingSection
+	{
+		String name;
+		var data; //void when the section did not change since the last snapshot
+	};
+
+	CriticalSection pendingLock;
+	File pendingFile;
+	Array<PendingSection> pending;
+
+	OwnedArray<ProjectSnapshot::Section> cachedSections; //writer thread only
+
+	std::function<void()> onAutoSnapshot; //called every second on the message thread
+
+	void save(const File& file, const Array<PendingSection>& sections);
+
+	void run() override;
+	void timerCallback() override;
+
+private:
+	ProjectSnapshot::Section* getCachedSection(const String& name);
+
+	JUCE_DECLARE_NON_COPYABLE(ProjectSnapshotWriter)
+};
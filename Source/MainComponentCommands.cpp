@@ -28,6 +28,9 @@ namespace ChataigneCommandIDs
 	static const int reloadCustomModules = 0x501;
 	static const int exportSelection = 0x800;
 	static const int importSelection = 0x801;
+	static const int saveSnapshot = 0x802;
+	static const int recoverSnapshot = 0x803;
+	static const int convertToSnapshot = 0x804;
 
 }
 
@@ -102,6 +105,18 @@ void MainContentComponent::getCommandInfo(CommandID commandID, ApplicationComman
 		result.addDefaultKeypress(KeyPress::createFromDescription("o").getKeyCode(), ModifierKeys::altModifier);
 		break;
 
+	case ChataigneCommandIDs::saveSnapshot:
+		result.setInfo("Save Snapshot...", "This will save the current noisette as a compact binary *.noisnap snapshot", "File", result.readOnlyInKeyEditor);
+		break;
+
+	case ChataigneCommandIDs::recoverSnapshot:
+		result.setInfo("Recover from Snapshot...", "This will convert a *.noisnap snapshot back to a noisette and open it", "File", result.readOnlyInKeyEditor);
+		break;
+
+	case ChataigneCommandIDs::convertToSnapshot:
+		result.setInfo("Convert Noisette to Snapshot...", "This will convert a saved *.noisette file to a *.noisnap snapshot next to it, without opening it", "File", result.readOnlyInKeyEditor);
+		break;
+
 	default:
 		OrganicMainContentComponent::getCommandInfo(commandID, result);
 		break;
@@ -127,6 +142,9 @@ void MainContentComponent::getAllCommands(Array<CommandID>& commands) {
 		ChataigneCommandIDs::postGithubIssue,
 		ChataigneCommandIDs::importSelection,
 		ChataigneCommandIDs::exportSelection,
+		ChataigneCommandIDs::saveSnapshot,
+		ChataigneCommandIDs::recoverSnapshot,
+		ChataigneCommandIDs::convertToSnapshot,
 		ChataigneCommandIDs::goToCommunityModules,
 		ChataigneCommandIDs::reloadCustomModules,
 		ChataigneCommandIDs::exitGuide,
@@ -174,6 +192,10 @@ void MainContentComponent::fillFileMenuInternal(PopupMenu& menu)
 	menu.addCommandItem(&getCommandManager(), ChataigneCommandIDs::importSelection);
 	menu.addCommandItem(&getCommandManager(), ChataigneCommandIDs::exportSelection);
 	menu.addSeparator();
+	menu.addCommandItem(&getCommandManager(), ChataigneCommandIDs::saveSnapshot);
+	menu.addCommandItem(&getCommandManager(), ChataigneCommandIDs::recoverSnapshot);
+	menu.addCommandItem(&getCommandManager(), ChataigneCommandIDs::convertToSnapshot);
+	menu.addSeparator();
 	menu.addCommandItem(&getCommandManager(), ChataigneCommandIDs::goToCommunityModules);
 	menu.addCommandItem(&getCommandManager(), ChataigneCommandIDs::reloadCustomModules);
 }
@@ -261,6 +283,24 @@ bool MainContentComponent::perform(const InvocationInfo& info)
 	}
 	break;
 
+	case ChataigneCommandIDs::saveSnapshot:
+	{
+		((ChataigneEngine*)Engine::mainEngine)->saveSnapshot();
+	}
+	break;
+
+	case ChataigneCommandIDs::recoverSnapshot:
+	{
+		((ChataigneEngine*)Engine::mainEngine)->recoverFromSnapshot();
+	}
+	break;
+
+	case ChataigneCommandIDs::convertToSnapshot:
+	{
+		((ChataigneEngine*)Engine::mainEngine)->convertToSnapshot();
+	}
+	break;
+
 	default:
 		return OrganicMainContentComponent::perform(info);
 	}
@@ -61,10 +61,13 @@ Module::Module(const String& name) :
 	scriptManager->scriptTemplate = ChataigneAssetManager::getInstance()->getScriptTemplateBundle(StringArray("generic", "module"));
 
 	scriptCommanDef.reset(CommandDefinition::createDef(this, "", "Script callback", &ScriptCallbackCommand::create));
+
+	scriptCallbackWatcher.reset(new ScriptCallbackWatcher(this));
 }
 
 Module::~Module()
 {
+	scriptCallbackWatcher.reset();
 	clearItem();
 }
 
@@ -144,20 +147,100 @@ void Module::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Con
 {
 	if (cc == &valuesCC)
 	{
-		Array<var> args;
-		args.add(c->getScriptObject());
-		scriptManager->callFunctionOnAllItems("moduleValueChanged", args);
+		if (hasScriptCallback(moduleValueChangedId))
+		{
+			Array<var> args;
+			args.add(c->getScriptObject());
+			scriptManager->callFunctionOnAllItems(moduleValueChangedId, args);
+		}
 	}
 	else if (cc == &moduleParams)
 	{
-		Array<var> args;
-		args.add(c->getScriptObject());
-		scriptManager->callFunctionOnAllItems("moduleParameterChanged", args);
+		if (hasScriptCallback(moduleParameterChangedId))
+		{
+			Array<var> args;
+			args.add(c->getScriptObject());
+			scriptManager->callFunctionOnAllItems(moduleParameterChangedId, args);
+		}
+	}
+	else if (cc != nullptr && cc->parentContainer == scriptManager.get())
+	{
+		updateScriptCallbacks(); //a script has been enabled or disabled
 	}
 
 	if (c->type != Controllable::TRIGGER) processDependencies((Parameter*)c);
 }
 
+bool Module::hasScriptCallback(const Identifier& callbackId)
+{
+	GenericScopedLock lock(scriptCallbackLock);
+	return declaredScriptFunctions.contains(callbackId);
+}
+
+void Module::updateScriptCallbacks(Array<Script*> removedScripts)
+{
+	Array<Identifier> callbacks;
+	for (auto& s : scriptManager->items)
+	{
+		if (removedScripts.contains(s)) continue;
+		if (s->enabled != nullptr && !s->enabled->boolValue()) continue;
+		if (s->state != Script::ScriptState::SCRIPT_LOADED || s->scriptEngine == nullptr) continue;
+
+		//script functions are FunctionObjects, which show as objects and only differ from other objects by serializing as their code
+		const NamedValueSet props = s->scriptEngine->getRootObjectProperties();
+		for (auto& sp : props)
+		{
+			if (sp.value.isMethod() || (sp.value.isObject() && JSON::toString(sp.value, true).startsWith("function"))) callbacks.addIfNotAlreadyThere(sp.name);
+		}
+	}
+
+	GenericScopedLock lock(scriptCallbackLock);
+	declaredScriptFunctions.swapWith(callbacks);
+}
+
+Module::ScriptCallbackWatcher::ScriptCallbackWatcher(Module* module) :
+	module(module)
+{
+	module->scriptManager->addBaseManagerListener(this);
+	for (auto& s : module->scriptManager->items) s->addAsyncScriptListener(this);
+	module->updateScriptCallbacks();
+}
+
+Module::ScriptCallbackWatcher::~ScriptCallbackWatcher()
+{
+	module->scriptManager->removeBaseManagerListener(this);
+	for (auto& s : module->scriptManager->items) s->removeAsyncScriptListener(this);
+}
+
+void Module::ScriptCallbackWatcher::itemAdded(Script* s)
+{
+	s->addAsyncScriptListener(this);
+	module->updateScriptCallbacks();
+}
+
+void Module::ScriptCallbackWatcher::itemsAdded(Array<Script*> scripts)
+{
+	for (auto& s : scripts) s->addAsyncScriptListener(this);
+	module->updateScriptCallbacks();
+}
+
+void Module::ScriptCallbackWatcher::itemRemoved(Script* s)
+{
+	s->removeAsyncScriptListener(this);
+	module->updateScriptCallbacks(Array<Script*>(s));
+}
+
+void Module::ScriptCallbackWatcher::itemsRemoved(Array<Script*> scripts)
+{
+	for (auto& s : scripts) s->removeAsyncScriptListener(this);
+	module->updateScriptCallbacks(scripts);
+}
+
+void Module::ScriptCallbackWatcher::newMessage(const Script::ScriptEvent&)
+{
+	module->updateScriptCallbacks(); //state changes, a recompiled script has a new engine
+}
+
 var Module::getJSONData()
 {
 	var data = BaseItem::getJSONData();
@@ -334,6 +417,7 @@ void Module::createControllablesForContainer(var data, ControllableContainer* cc
 						{
 							Dependency* d = new Dependency(sourceP, param, depVar.getProperty("value", 0), depVar.getProperty("check", "").toString(), depVar.getProperty("action", "").toString());
 							dependencies.add(d);
+							dependencyMap.getReference(sourceP).add(d);
 						}
 						else
 						{
@@ -360,16 +444,25 @@ void Module::onContainerNiceNameChanged()
 void Module::processDependencies(Parameter* p)
 {
 	//Dependencies
+	if (!dependencyMap.contains(p)) return;
+
 	bool changed = false;
-	for (auto& d : dependencies)
+	for (auto& d : dependencyMap.getReference(p))
 	{
-
-		if (d->source == p) if (d->process()) changed = true;
+		if (d->process()) changed = true;
 	}
 
-	if (changed)
+	//Coalesce all rebuilds happening before the next message loop pass into a single one
+	if (changed && !dependencyRebuildPending.exchange(true))
 	{
-		queuedNotifier.addMessage(new ContainerAsyncEvent(ContainerAsyncEvent::ControllableContainerNeedsRebuild, this));
+		WeakReference<Inspectable> moduleRef(this);
+		MessageManager::callAsync([this, moduleRef]()
+			{
+				if (moduleRef.wasObjectDeleted()) return;
+				dependencyRebuildPending = false;
+				queuedNotifier.addMessage(new ContainerAsyncEvent(ContainerAsyncEvent::ControllableContainerNeedsRebuild, this));
+			}
+		);
 	}
 }
 
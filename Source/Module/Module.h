@@ -102,7 +102,8 @@ public:
 	};
 
 	OwnedArray<Dependency> dependencies;
-	HashMap<Parameter *, Dependency *> dependencyMap;
+	HashMap<Parameter *, Array<Dependency *>> dependencyMap; //indexed by source, filled when creating controllables from the module definition
+	Atomic<bool> dependencyRebuildPending;
 
 	void processDependencies(Parameter * p);
 
@@ -120,6 +121,35 @@ public:
 	virtual ModuleRouterController* createModuleRouterController(ModuleRouter* router) { return nullptr; }
 
 	virtual void onControllableFeedbackUpdateInternal(ControllableContainer * cc, Controllable * c) override;
+
+	//Script callbacks
+	const Identifier moduleValueChangedId = "moduleValueChanged";
+	const Identifier moduleParameterChangedId = "moduleParameterChanged";
+
+	//Keeps the list of functions declared by the enabled scripts, rebuilt on the message thread when a script is added, removed or recompiled
+	class ScriptCallbackWatcher :
+		public ScriptManager::ManagerListener,
+		public Script::AsyncListener
+	{
+	public:
+		ScriptCallbackWatcher(Module* module);
+		~ScriptCallbackWatcher();
+
+		Module* module;
+
+		void itemAdded(Script* s) override;
+		void itemsAdded(Array<Script*> scripts) override;
+		void itemRemoved(Script* s) override;
+		void itemsRemoved(Array<Script*> scripts) override;
+		void newMessage(const Script::ScriptEvent&) override;
+	};
+
+	std::unique_ptr<ScriptCallbackWatcher> scriptCallbackWatcher;
+	Array<Identifier> declaredScriptFunctions;
+	SpinLock scriptCallbackLock;
+
+	void updateScriptCallbacks(Array<Script*> removedScripts = Array<Script*>());
+	bool hasScriptCallback(const Identifier& callbackId); //Check before marshalling arguments, true if at least one enabled and loaded script declares this function
 	
 	var getJSONData() override;
 	void loadJSONDataItemInternal(var data) override;
@@ -51,6 +51,7 @@
 #include "modules/audio/AudioModule.cpp"
 #include "modules/audio/analysis/FFTAnalyzer.cpp"
 #include "modules/audio/analysis/FFTAnalyzerManager.cpp"
+#include "modules/audio/analysis/OnsetDetector.cpp"
 #include "modules/audio/analysis/ui/FFTAnalyzerEditor.cpp"
 #include "modules/audio/analysis/ui/FFTAnalyzerManagerEditor.cpp"
 #include "modules/audio/commands/PlayAudioFileCommand.cpp"
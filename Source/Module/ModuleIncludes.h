@@ -37,6 +37,7 @@
 
 #include "modules/audio/analysis/FFTAnalyzer.h"
 #include "modules/audio/analysis/FFTAnalyzerManager.h"
+#include "modules/audio/analysis/OnsetDetector.h"
 
 #include "modules/audio/AudioModule.h"
 
@@ -197,6 +198,8 @@
 #include "modules/tcp/tcpserver/TCPServerConnectionManager.h"
 #include "modules/tcp/tcpserver/TCPServerModule.h"
 
+#include "modules/mqtt/topics/MQTTTopic.h"
+#include "modules/mqtt/topics/MQTTTopicRouter.h"
 #include "modules/mqtt/MQTTModule.h"
 #include "modules/mqtt/commands/MQTTCommands.h"
 
@@ -42,6 +42,8 @@
 
 #include "modules/abletonlink/AbletonLinkModule.cpp"
 
+#include "modules/mqtt/topics/MQTTTopic.cpp"
+#include "modules/mqtt/topics/MQTTTopicRouter.cpp"
 #include "modules/mqtt/MQTTModule.cpp"
 #include "modules/mqtt/commands/MQTTCommands.cpp"
 
@@ -17,19 +17,29 @@ AudioModule::AudioModule(const String& name) :
 	curBufferIndex(0),
 	inputVolumesCC("Input Volumes"),
 	outputVolumesCC("Output Volumes"),
+	channelVolumesCC("Channel Volumes"),
 	monitorParams("Monitor"),
 	numActiveMonitorOutputs(0),
 	noteCC("Pitch Detection"),
 	fftCC("FFT Enveloppes"),
+	onsetParamsCC("Onset Detection"),
+	onsetCC("Onsets"),
+	lastOnsetCount(0),
+	lastBeatCount(0),
 	ltcParamsCC("LTC"),
 	ltcCC("LTC"),
 	ltcFrameDropCount(0),
+	ltcSamplePosition(0),
+	ltcDetected(false),
+	ltcExactTime(0),
+	ltcExactTimeMillis(0),
 	pitchDetector(nullptr)
 {
 	setupIOConfiguration(true, true);
 
 	inputGain = moduleParams.addFloatParameter("Input Gain", "Gain for the input volume", 1, 0, 10);
 	activityThreshold = moduleParams.addFloatParameter("Activity Threshold", "Threshold to consider activity from the source.\nAnalysis will compute only if volume is greater than this parameter", .1f, 0, 1);
+	analysisChannel = moduleParams.addIntParameter("Analysis Channel", "Input channel used to compute volume and pitch", 1, 1, 64);
 	keepLastDetectedValues = moduleParams.addBoolParameter("Keep Values", "Keep last detected values when no activity detected.", false);
 
 	outVolume = moduleParams.addFloatParameter("Out Volume", "Global volume multiplier for all sound that is played through this module", 1, 0, 10);
@@ -52,6 +62,14 @@ AudioModule::AudioModule(const String& name) :
 	analyzerManager.addBaseManagerListener(this);
 
 
+	//Onsets
+	onsetParamsCC.enabled->setValue(false);
+	moduleParams.addChildControllableContainer(&onsetParamsCC);
+	onsetSensitivity = onsetParamsCC.addFloatParameter("Sensitivity", "Higher values detect softer onsets, lower values only keep the strongest ones", .5f, 0, 1);
+	onsetMinInterval = onsetParamsCC.addFloatParameter("Min Interval", "Minimum time between two onsets, in seconds", .1f, .02f, 1);
+	minBPM = onsetParamsCC.addFloatParameter("Min BPM", "Lowest tempo the beat tracker will consider", 70, 30, 300);
+	maxBPM = onsetParamsCC.addFloatParameter("Max BPM", "Highest tempo the beat tracker will consider", 180, 30, 300);
+
 	//LTC
 	ltcParamsCC.enabled->setValue(false);
 	moduleParams.addChildControllableContainer(&ltcParamsCC);
@@ -63,7 +81,10 @@ AudioModule::AudioModule(const String& name) :
 	ltcChannel = ltcParamsCC.addIntParameter("LTC Channel", "Enable and select the channel you want to use to decode LTC", 1, 1, 64);
 
 	//Values
-	detectedVolume = valuesCC.addFloatParameter("Volume", "Volume of the audio input", 0, 0, 1);
+	detectedVolume = valuesCC.addFloatParameter("Volume", "Volume of the analysis channel", 0, 0, 1);
+
+	channelVolumesCC.editorIsCollapsed = true;
+	valuesCC.addChildControllableContainer(&channelVolumesCC);
 
 	//Pitch Detection
 	frequency = noteCC.addFloatParameter("Freq", "Freq", 0, 0, 2000);
@@ -79,6 +100,15 @@ AudioModule::AudioModule(const String& name) :
 	//FFT
 	valuesCC.addChildControllableContainer(&fftCC);
 
+	//Onsets
+	valuesCC.addChildControllableContainer(&onsetCC);
+	onsetTrigger = onsetCC.addTrigger("Onset", "Triggered when an onset is detected on the analysis channel");
+	onsetStrength = onsetCC.addFloatParameter("Onset Strength", "Spectral flux of the analysis channel, relative to its recent peak", 0, 0, 1);
+	beatTrigger = onsetCC.addTrigger("Beat", "Triggered on each beat predicted by the tempo tracker");
+	bpm = onsetCC.addFloatParameter("BPM", "Tempo estimated from the onsets", 0, 0, 300);
+	beatPhase = onsetCC.addFloatParameter("Beat Phase", "Position between the last and the next beat", 0, 0, 1);
+	for (auto& c : onsetCC.controllables) c->setControllableFeedbackOnly(true);
+
 
 	//LTC
 	valuesCC.addChildControllableContainer(&ltcCC);
@@ -86,6 +116,61 @@ AudioModule::AudioModule(const String& name) :
 	ltcTime = ltcCC.addFloatParameter("LTC Time", "Decoded LTC Time from the selected channel in parameters", 0, 0);
 	ltcTime->defaultUI = FloatParameter::TIME;
 
+	ParameterPublisher* publisher = ParameterPublisher::getInstance();
+	volumeSlot = publisher->addSlot(detectedVolume);
+	frequencySlot = publisher->addSlot(frequency);
+	pitchSlot = publisher->addSlot(pitch);
+	pitchSlot->applyFunc = [this](const double* v, int, double)
+	{
+		int pitchNote = (int)v[0];
+		if (pitchNote < 0)
+		{
+			pitch->setValue(0);
+			note->setValueWithKey("-");
+			return;
+		}
+
+		pitch->setValue(pitchNote);
+		note->setValueWithKey(MIDIManager::getNoteName(pitchNote, false));
+		octave->setValue(floor(pitchNote / 12.0));
+	};
+
+	//time first, so sequences chasing LTC see the new time before the play state
+	ltcTimeSlot = publisher->addSlot(ltcTime);
+	ltcTimeSlot->applyFunc = [this](const double* v, int, double timestamp)
+	{
+		ltcExactTime = v[0];
+		ltcExactTimeMillis = timestamp;
+		ltcTime->setValue(ltcExactTime);
+	};
+	ltcPlayingSlot = publisher->addSlot(ltcPlaying);
+
+	//counters are published along the values, so onsets or beats happening between two deliveries are not lost
+	onsetSlot = publisher->addSlot(onsetStrength);
+	onsetSlot->applyFunc = [this](const double* v, int, double)
+	{
+		onsetStrength->setValue(v[0]);
+		int count = (int)v[1];
+		if (count != lastOnsetCount)
+		{
+			lastOnsetCount = count;
+			onsetTrigger->trigger();
+		}
+	};
+
+	beatSlot = publisher->addSlot(bpm);
+	beatSlot->applyFunc = [this](const double* v, int, double)
+	{
+		bpm->setValue(v[0]);
+		beatPhase->setValue(v[1]);
+		int count = (int)v[2];
+		if (count != lastBeatCount)
+		{
+			lastBeatCount = count;
+			beatTrigger->trigger();
+		}
+	};
+
 
 	//AUDIO
 	am.addAudioCallback(this);
@@ -141,6 +226,18 @@ AudioModule::~AudioModule()
 
 	am.removeAudioCallback(this);
 	am.removeChangeListener(this);
+
+	if (ParameterPublisher* publisher = ParameterPublisher::getInstanceWithoutCreating())
+	{
+		publisher->removeSlot(volumeSlot);
+		publisher->removeSlot(frequencySlot);
+		publisher->removeSlot(pitchSlot);
+		publisher->removeSlot(ltcTimeSlot);
+		publisher->removeSlot(ltcPlayingSlot);
+		publisher->removeSlot(onsetSlot);
+		publisher->removeSlot(beatSlot);
+		for (auto& s : channelVolumeSlots) publisher->removeSlot(s);
+	}
 }
 
 void AudioModule::updateAudioSetup()
@@ -207,6 +304,10 @@ void AudioModule::updateAudioSetup()
 	}
 	inputVolumesCC.loadJSONData(inData);
 
+	updateChannelVolumes(numInputChannels);
+	onsetDetector.setSampleRate(currentSampleRate);
+	analyzerManager.setNumChannels(numInputChannels);
+
 	AudioChannelSet outputChannelSet = graph.getChannelLayoutOfBus(false, 0);
 	for (int i = 0; i < numOutputChannels; ++i)
 	{
@@ -231,6 +332,29 @@ void AudioModule::updateAudioSetup()
 	graph.suspendProcessing(false);
 }
 
+void AudioModule::updateChannelVolumes(int numInputChannels)
+{
+	ParameterPublisher* publisher = ParameterPublisher::getInstance();
+
+	//only the difference is removed or added, existing channels keep their parameter and the mappings using it
+	while (channelVolumes.size() > numInputChannels)
+	{
+		publisher->removeSlot(channelVolumeSlots.getLast());
+		channelVolumeSlots.removeLast();
+
+		channelVolumesCC.removeControllable(channelVolumes.getLast());
+		channelVolumes.removeLast();
+	}
+
+	while (channelVolumes.size() < numInputChannels)
+	{
+		FloatParameter* v = channelVolumesCC.addFloatParameter("Input " + String(channelVolumes.size() + 1) + " Volume", "Volume of this input channel", 0, 0, 1);
+		v->setControllableFeedbackOnly(true);
+		channelVolumes.add(v);
+		channelVolumeSlots.add(publisher->addSlot(v));
+	}
+}
+
 void AudioModule::updateSelectedMonitorChannels()
 {
 	selectedMonitorOutChannels.clear();
@@ -269,13 +393,31 @@ void AudioModule::onControllableFeedbackUpdateInternal(ControllableContainer* cc
 		}
 
 	}
+	else if (c == onsetParamsCC.enabled)
+	{
+		if (!onsetParamsCC.enabled->boolValue())
+		{
+			onsetDetector.requestReset(); //the audio thread may be processing, it resets itself before the next block
+			onsetStrength->setValue(0);
+			bpm->setValue(0);
+			beatPhase->setValue(0);
+		}
+	}
+	else if (c == onsetSensitivity) onsetDetector.sensitivity = onsetSensitivity->floatValue();
+	else if (c == onsetMinInterval) onsetDetector.minInterval = onsetMinInterval->floatValue();
+	else if (c == minBPM) onsetDetector.minBPM = minBPM->floatValue();
+	else if (c == maxBPM) onsetDetector.maxBPM = maxBPM->floatValue();
 	else if (c == ltcFPS)
 	{
 		curLTCFPS = (int)ltcFPS->getValueData();
 	}
 	else if (c == ltcParamsCC.enabled)
 	{
-		if (!ltcParamsCC.enabled->boolValue()) ltcPlaying->setValue(false);
+		if (!ltcParamsCC.enabled->boolValue())
+		{
+			ltcDetected = false;
+			ltcPlaying->setValue(false);
+		}
 	}
 }
 
@@ -345,17 +487,41 @@ void AudioModule::audioDeviceIOCallbackWithContext(const float* const* inputChan
 
 	if (!enabled->boolValue()) return;
 
+	const float gain = inputGain->floatValue();
+	const int analysisIndex = analysisChannel->intValue() - 1;
+
 	for (int i = 0; i < numInputChannels; ++i)
 	{
 		float channelVolume = i < inputVolumes.size() && inputVolumes[i] != nullptr ? inputVolumes[i]->floatValue() : 1;
 
-		if (i == 0) //take only the first channel for analysis (later, should be able to select which channel is used for analysis)
+		if (i < channelVolumeSlots.size())
+		{
+			float sum = 0;
+			const float* data = inputChannelData[i];
+			for (int s = 0; s < numSamples; ++s) sum += data[s] * data[s];
+			float rms = numSamples > 0 ? std::sqrt(sum / numSamples) * gain * channelVolume : 0;
+			channelVolumeSlots.getUnchecked(i)->publish(rms);
+		}
+
+		if (i == analysisIndex)
 		{
 			if (buffer.getNumSamples() != numSamples) buffer.setSize(1, numSamples);
-			buffer.copyFromWithRamp(0, 0, inputChannelData[0], numSamples, 1, inputGain->floatValue() * channelVolume);
-			detectedVolume->setValue(buffer.getRMSLevel(0, 0, numSamples));
+			buffer.copyFromWithRamp(0, 0, inputChannelData[i], numSamples, 1, gain * channelVolume);
+			float rms = buffer.getRMSLevel(0, 0, numSamples);
+			volumeSlot->publish(rms);
+
+			if (onsetParamsCC.enabled->boolValue())
+			{
+				onsetDetector.process(buffer.getReadPointer(0), numSamples);
+
+				double onsetValues[2] = { onsetDetector.strength, (double)onsetDetector.onsetCount };
+				onsetSlot->publish(onsetValues, 2);
+
+				double beatValues[3] = { onsetDetector.getBPM(), onsetDetector.getBeatPhase(), (double)onsetDetector.beatCount };
+				beatSlot->publish(beatValues, 3);
+			}
 
-			if (detectedVolume->floatValue() > activityThreshold->floatValue())
+			if (rms > activityThreshold->floatValue())
 			{
 				inActivityTrigger->trigger();
 
@@ -363,15 +529,11 @@ void AudioModule::audioDeviceIOCallbackWithContext(const float* const* inputChan
 				{
 					if ((int)pitchDetector->getBufferSize() != numSamples) pitchDetector->setBufferSize(numSamples);
 
-					if (inputChannelData[0][0] >= 0)
+					if (inputChannelData[i][0] >= 0)
 					{
-						float freq = pitchDetector->getPitch(inputChannelData[0]);
-						frequency->setValue(freq);
-						int pitchNote = getNoteForFrequency(freq);
-						pitch->setValue(pitchNote);
-
-						note->setValueWithKey(MIDIManager::getNoteName(pitchNote, false));
-						octave->setValue(floor(pitchNote / 12.0));
+						float freq = pitchDetector->getPitch(inputChannelData[i]);
+						frequencySlot->publish(freq);
+						pitchSlot->publish(getNoteForFrequency(freq));
 					}
 				}
 			}
@@ -379,59 +541,68 @@ void AudioModule::audioDeviceIOCallbackWithContext(const float* const* inputChan
 			{
 				if (!keepLastDetectedValues->boolValue())
 				{
-					frequency->setValue(0);
-					pitch->setValue(0);
-					note->setValueWithKey("-");
+					frequencySlot->publish(0);
+					pitchSlot->publish(-1);
 				}
 			}
 		}
 
-		//Analysis
-		analyzerManager.process(inputChannelData[0], numSamples);
-
-		if (ltcParamsCC.enabled->boolValue())
+		//Monitor
+		if (monitorParams.enabled->boolValue())
 		{
-			int channel = ltcChannel->intValue() - 1;
-			if (channel >= 0 && channel < numInputChannels)
+			for (int j = 0; j < numActiveMonitorOutputs; j++)
 			{
-				ltc_decoder_write_float(ltcDecoder.get(), (float*)inputChannelData[channel], numSamples, 0);
+				int outputIndex = selectedMonitorOutChannels[j];
+				if (outputIndex >= numOutputChannels) continue;
+				FloatVectorOperations::addWithMultiply(outputChannelData[outputIndex], inputChannelData[i], monitorVolume->floatValue() * channelVolume, numSamples);
+			}
+		}
+	}
 
-				bool hasLTC = false;
-				LTCFrameExt frame;
-				while (ltc_decoder_read(ltcDecoder.get(), &frame))
-				{
-					SMPTETimecode stime;
-					ltc_frame_to_time(&stime, &frame.ltc, 1);
+	//Analysis, all channels at once so the analyzer thread is woken at most once per callback
+	analyzerManager.process(inputChannelData, numInputChannels, numSamples);
 
-					float time = stime.days * 3600 * 24 + stime.hours * 3600 + stime.mins * 60 + stime.secs + stime.frame * 1.0f / curLTCFPS;
-					ltcTime->setValue(time);
-					hasLTC = true;
-				}
+	if (ltcParamsCC.enabled->boolValue())
+	{
+		int channel = ltcChannel->intValue() - 1;
+		if (channel >= 0 && channel < numInputChannels)
+		{
+			ltc_decoder_write_float(ltcDecoder.get(), (float*)inputChannelData[channel], numSamples, ltcSamplePosition);
+			ltcSamplePosition += numSamples;
+
+			bool hasLTC = false;
+			LTCFrameExt frame;
+			while (ltc_decoder_read(ltcDecoder.get(), &frame))
+			{
+				SMPTETimecode stime;
+				ltc_frame_to_time(&stime, &frame.ltc, 1);
+
+				double frameTime = stime.days * 3600.0 * 24 + stime.hours * 3600.0 + stime.mins * 60.0 + stime.secs + stime.frame * 1.0 / curLTCFPS;
+				double elapsed = currentSampleRate > 0 ? (ltcSamplePosition - frame.off_start) / currentSampleRate : 0;
+				ltcTimeSlot->publish(frameTime + jlimit(0.0, 1.0, elapsed));
+				hasLTC = true;
+			}
 
-				if (!hasLTC)
+			if (!hasLTC)
+			{
+				if (ltcDetected)
 				{
-					if (ltcPlaying->boolValue())
+					ltcFrameDropCount++;
+					if (ltcFrameDropCount >= 10)
 					{
-						ltcFrameDropCount++;
-						if (ltcFrameDropCount >= 10) ltcPlaying->setValue(hasLTC);
+						ltcDetected = false;
+						ltcPlayingSlot->publish(0);
 					}
 				}
-				else
-				{
-					ltcFrameDropCount = 0;
-					ltcPlaying->setValue(true);
-				}
 			}
-		}
-
-		//Monitor
-		if (monitorParams.enabled->boolValue())
-		{
-			for (int j = 0; j < numActiveMonitorOutputs; j++)
+			else
 			{
-				int outputIndex = selectedMonitorOutChannels[j];
-				if (outputIndex >= numOutputChannels) continue;
-				FloatVectorOperations::addWithMultiply(outputChannelData[outputIndex], inputChannelData[i], monitorVolume->floatValue() * channelVolume, numSamples);
+				ltcFrameDropCount = 0;
+				if (!ltcDetected)
+				{
+					ltcDetected = true;
+					ltcPlayingSlot->publish(1);
+				}
 			}
 		}
 	}
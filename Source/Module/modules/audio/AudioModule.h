@@ -90,6 +90,7 @@ public:
 	//Parameters
 	FloatParameter* inputGain;
 	FloatParameter* activityThreshold;
+	IntParameter* analysisChannel;
 	FloatParameter* outVolume;
 
 	ControllableContainer inputVolumesCC;
@@ -109,6 +110,10 @@ public:
 	//Values
 	FloatParameter* detectedVolume;
 
+	ControllableContainer channelVolumesCC;
+	Array<FloatParameter*> channelVolumes;
+	Array<ParameterPublisher::Slot*> channelVolumeSlots;
+
 	ControllableContainer noteCC;
 	FloatParameter* frequency;
 	IntParameter* pitch;
@@ -117,6 +122,21 @@ public:
 
 	ControllableContainer fftCC;
 
+	EnablingControllableContainer onsetParamsCC;
+	FloatParameter* onsetSensitivity;
+	FloatParameter* onsetMinInterval;
+	FloatParameter* minBPM;
+	FloatParameter* maxBPM;
+
+	ControllableContainer onsetCC;
+	Trigger* onsetTrigger;
+	FloatParameter* onsetStrength;
+	Trigger* beatTrigger;
+	FloatParameter* bpm;
+	FloatParameter* beatPhase;
+	int lastOnsetCount; //consumer side, to fire triggers once per detected onset / beat
+	int lastBeatCount;
+
 	EnablingControllableContainer ltcParamsCC;
 	EnumParameter* ltcFPS;
 	int curLTCFPS; //avoid accessing enum in audio thread
@@ -126,13 +146,28 @@ public:
 	BoolParameter* ltcPlaying;
 	FloatParameter* ltcTime;
 	int ltcFrameDropCount;
+	int64 ltcSamplePosition; //running input sample count, so decoded frames can be placed with sub-frame accuracy
+	bool ltcDetected; //audio thread side of ltcPlaying
+	double ltcExactTime; //decoded time at the end of the last processed block, kept in double for long timecodes
+	double ltcExactTimeMillis; //hi-res time at which ltcExactTime was decoded
+
+	//values computed in the audio thread are published here and applied by ParameterPublisher, so no listener runs in the audio callback
+	ParameterPublisher::Slot* volumeSlot;
+	ParameterPublisher::Slot* frequencySlot;
+	ParameterPublisher::Slot* pitchSlot;
+	ParameterPublisher::Slot* ltcTimeSlot;
+	ParameterPublisher::Slot* ltcPlayingSlot;
+	ParameterPublisher::Slot* onsetSlot;
+	ParameterPublisher::Slot* beatSlot;
 
 	FFTAnalyzerManager analyzerManager;
 
 	std::unique_ptr<PitchDetector> pitchDetector;
+	OnsetDetector onsetDetector;
 	std::unique_ptr<LTCDecoder> ltcDecoder;
 
 	virtual void updateAudioSetup();
+	void updateChannelVolumes(int numInputChannels);
 	void updateSelectedMonitorChannels();
 
 	void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
@@ -11,11 +11,13 @@
 FFTAnalyzer::FFTAnalyzer() :
 	BaseItem("Analyzer 1")
 {
+	channel = addIntParameter("Channel", "Input channel this analyzer listens to", 1, 1, 64);
 	position = addFloatParameter("Position", "", .5f, 0, 1);
 	size = addFloatParameter("Size", "", .1f, 0, 1);
 
 	value = new FloatParameter(niceName + " value", "", 0, 0, 1);
 	value->setControllableFeedbackOnly(true);
+	valueSlot = ParameterPublisher::getInstance()->addSlot(value);
 
 	Random r;
 	setHasCustomColor(true);
@@ -24,7 +26,7 @@ FFTAnalyzer::FFTAnalyzer() :
 
 FFTAnalyzer::~FFTAnalyzer()
 {
-
+	if (ParameterPublisher* publisher = ParameterPublisher::getInstanceWithoutCreating()) publisher->removeSlot(valueSlot);
 }
 
 
@@ -54,7 +56,7 @@ void FFTAnalyzer::process(float* fftSamples, int numSamples)
 	if (totalCoef > 0)
 	{
 		result /= totalCoef;
-		value->setValue(result);
+		valueSlot->publish(result);
 	}
 }
 
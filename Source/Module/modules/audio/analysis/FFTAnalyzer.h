@@ -18,10 +18,13 @@ public:
 	~FFTAnalyzer();
 	
 	
+	IntParameter* channel;
 	FloatParameter* position;
 	FloatParameter* size;
 	FloatParameter * value;
 
+	ParameterPublisher::Slot* valueSlot; //process() runs on the analysis thread
+
 	void process(float * fftSamples, int numSamples);
 
 	void onContainerNiceNameChanged() override;
@@ -10,8 +10,10 @@
 
 FFTAnalyzerManager::FFTAnalyzerManager() :
 	BaseManager("FFT Analysis"),
-	forwardFFT(fftOrder),
-	window(fftSize, dsp::WindowingFunction<float>::hann)
+	Thread("FFT Analysis"),
+	hopDivision(1),
+	numInputChannels(0),
+	pool(jlimit(1, 4, SystemStats::getNumCpus() - 1))
 {
 	setCanBeDisabled(true);
 	enabled->setValue(false);
@@ -21,60 +23,235 @@ FFTAnalyzerManager::FFTAnalyzerManager() :
 	minDB = addFloatParameter("Min DB", "", -100, -100, 20);
 	maxDB = addFloatParameter("Max DB", "", 0, -100, 20);
 
+	fftSize = addEnumParameter("FFT Size", "Number of samples per analysis window. Bigger sizes give a finer frequency resolution but react slower");
+	for (int order = 8; order <= 13; order++) fftSize->addOption(String(1 << order), order);
+	fftSize->setDefaultValue(11);
+
+	hopSize = addEnumParameter("Hop Size", "Number of new samples between two analyses, relative to the FFT Size. Smaller hops give more frequent updates at the cost of more computation");
+	hopSize->addOption("Full Window", 1)->addOption("1/2 Window", 2)->addOption("1/4 Window", 4)->addOption("1/8 Window", 8);
+
+	FloatVectorOperations::clear(scopeData, scopeSize);
+
 	selectItemWhenCreated = false;
+
+	rebuildChannels();
+	startThread();
 }
 
 FFTAnalyzerManager::~FFTAnalyzerManager()
 {
+	stopThread(1000);
+	pool.removeAllJobs(true, 1000);
+}
+
+void FFTAnalyzerManager::setNumChannels(int numChannels)
+{
+	if (numChannels == numInputChannels) return;
+	numInputChannels = numChannels;
+	rebuildChannels();
 }
 
+void FFTAnalyzerManager::rebuildChannels()
+{
+	int order = (int)fftSize->getValueData();
 
+	GenericScopedLock aLock(analysisLock);
+	GenericScopedLock cLock(channelsLock);
 
-void FFTAnalyzerManager::process(const float* samples, int numSamples)
+	channels.clear();
+	for (int i = 0; i < numInputChannels; i++) channels.add(new ChannelAnalysis(order));
+	window.reset(new dsp::WindowingFunction<float>(1 << order, dsp::WindowingFunction<float>::hann, false));
+
+	updateUsedChannels();
+}
+
+void FFTAnalyzerManager::updateUsedChannels()
+{
+	for (int i = 0; i < channels.size(); i++) channels[i]->isUsed = i == 0; //first channel is always analyzed for the editor
+
+	for (auto& a : analyzers)
+	{
+		if (!a->enabled->boolValue()) continue;
+		int channel = a->channel->intValue() - 1;
+		if (channel >= 0 && channel < channels.size()) channels[channel]->isUsed = true;
+	}
+}
+
+
+void FFTAnalyzerManager::process(const float* const* inputChannelData, int numChannels, int numSamples)
 {
 	if (!enabled->boolValue()) return;
 
-	for (auto i = 0; i < numSamples; ++i) pushNextSampleIntoFifo(samples[i]);
-	window.multiplyWithWindowingTable(fftData, fftSize);      // [1]
+	GenericScopedTryLock<SpinLock> lock(channelsLock);
+	if (!lock.isLocked()) return;
+
+	bool hasNewBlock = false;
+	for (int i = 0; i < numChannels && i < channels.size(); i++)
+	{
+		ChannelAnalysis* ch = channels.getUnchecked(i);
+		if (!ch->isUsed) continue;
+		hasNewBlock |= ch->push(inputChannelData[i], numSamples, ch->fftSize / hopDivision);
+	}
+
+	if (hasNewBlock) notify();
+}
+
+void FFTAnalyzerManager::analyzeChannel(int channelIndex)
+{
+	ChannelAnalysis* ch = channels[channelIndex];
+	const int size = ch->fftSize;
+
+	FloatVectorOperations::copy(ch->fftData, ch->readyBlock, size);
+	ch->blockReady = false;
+	FloatVectorOperations::clear(ch->fftData + size, size);
+
+	//window once per analyzed block, not on every audio callback
+	window->multiplyWithWindowingTable(ch->fftData, (size_t)size);
+	ch->fft.performFrequencyOnlyForwardTransform(ch->fftData);
 
+	auto mindB = minDB->floatValue();
+	auto maxdB = jmax<float>(maxDB->floatValue(), mindB);
+	const float sizeDB = Decibels::gainToDecibels((float)size);
 
-	if (nextFFTBlockReady)
+	for (int i = 0; i < scopeSize; ++i)
 	{
-		forwardFFT.performFrequencyOnlyForwardTransform(fftData);
+		auto skewedProportionX = 1.0f - std::exp(std::log(1.0f - i / (float)scopeSize) * 0.2f);
+		auto fftDataIndex = jlimit(0, size / 2, (int)(skewedProportionX * size / 2));
+		auto level = jmap(jlimit(mindB, maxdB, Decibels::gainToDecibels(ch->fftData[fftDataIndex]) - sizeDB), mindB, maxdB, 0.0f, 1.0f);
+		ch->scopeData[i] = level;
+	}
+
+	if (channelIndex == 0) memcpy(scopeData, ch->scopeData, sizeof(scopeData));
+
+	for (auto& a : analyzers)
+	{
+		if (a->channel->intValue() - 1 == channelIndex) a->process(ch->scopeData, scopeSize);
+	}
+}
+
+void FFTAnalyzerManager::run()
+{
+	Array<int> readyChannels;
+	WaitableEvent channelsDone;
+	Atomic<int> jobsLeft;
+
+	while (!threadShouldExit())
+	{
+		wait(100);
+		if (threadShouldExit()) break;
+
+		GenericScopedLock lock(analysisLock);
 
-		auto mindB = minDB->floatValue();
-		auto maxdB = jmax<float>(maxDB->floatValue(), mindB);
+		readyChannels.clearQuick();
+		for (int i = 0; i < channels.size(); i++) if (channels[i]->blockReady) readyChannels.add(i);
 
-		for (int i = 0; i < scopeSize; ++i)                        // [3]
+		if (readyChannels.size() == 1)
 		{
-			auto skewedProportionX = 1.0f - std::exp(std::log(1.0f - i / (float)scopeSize) * 0.2f);
-			auto fftDataIndex = jlimit(0, fftSize / 2, (int)(skewedProportionX * fftSize / 2));
-			auto level = jmap(jlimit(mindB, maxdB, Decibels::gainToDecibels(fftData[fftDataIndex]) - Decibels::gainToDecibels((float)fftSize)), mindB, maxdB, 0.0f, 1.0f);
-			scopeData[i] = level;                                  // [4]
+			analyzeChannel(readyChannels[0]);
+			continue;
 		}
 
-		for (auto& i : items) i->process(scopeData, scopeSize);
+		if (readyChannels.isEmpty()) continue;
 
-		nextFFTBlockReady = false;
+		//channels are independent, each one gets its own job so many inputs are analyzed concurrently
+		jobsLeft = readyChannels.size();
+		channelsDone.reset();
+
+		for (auto& c : readyChannels)
+		{
+			pool.addJob([this, c, &jobsLeft, &channelsDone]()
+				{
+					analyzeChannel(c);
+					if (--jobsLeft == 0) channelsDone.signal();
+				});
+		}
+
+		channelsDone.wait();
 	}
 }
 
-void FFTAnalyzerManager::pushNextSampleIntoFifo(float sample)
+void FFTAnalyzerManager::addItemInternal(FFTAnalyzer* item, var data)
 {
-	if (fifoIndex == fftSize)    // [11]
 	{
-		if (!nextFFTBlockReady) // [12]
-		{
-			zeromem(fftData, sizeof(fftData));
-			memcpy(fftData, fifo, sizeof(fifo));
-			nextFFTBlockReady = true;
-		}
-		fifoIndex = 0;
+		GenericScopedLock lock(analysisLock);
+		analyzers.add(item);
+	}
+	updateUsedChannels();
+}
+
+void FFTAnalyzerManager::removeItemInternal(FFTAnalyzer* item)
+{
+	{
+		GenericScopedLock lock(analysisLock);
+		analyzers.removeAllInstancesOf(item);
+	}
+	updateUsedChannels();
+}
+
+void FFTAnalyzerManager::onContainerParameterChanged(Parameter* p)
+{
+	BaseManager::onContainerParameterChanged(p);
+
+	if (p == fftSize) rebuildChannels();
+	else if (p == hopSize) hopDivision = (int)hopSize->getValueData();
+}
+
+void FFTAnalyzerManager::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c)
+{
+	BaseManager::onControllableFeedbackUpdateInternal(cc, c);
+
+	if (FFTAnalyzer* a = dynamic_cast<FFTAnalyzer*>(cc))
+	{
+		if (c == a->channel || c == a->enabled) updateUsedChannels();
 	}
-	fifo[fifoIndex++] = sample;  // [12]
 }
 
 InspectableEditor* FFTAnalyzerManager::getEditorInternal(bool isRoot, Array<Inspectable*> inspectables)
 {
 	return new FFTAnalyzerManagerEditor(this, isRoot);
-}
\ No newline at end of file
+}
+
+
+FFTAnalyzerManager::ChannelAnalysis::ChannelAnalysis(int fftOrder) :
+	fftSize(1 << fftOrder),
+	fft(fftOrder),
+	fifoIndex(0),
+	samplesSinceLastBlock(0),
+	blockReady(false),
+	isUsed(false)
+{
+	fifo.calloc(fftSize);
+	readyBlock.calloc(fftSize);
+	fftData.calloc(2 * fftSize);
+	FloatVectorOperations::clear(scopeData, scopeSize);
+}
+
+bool FFTAnalyzerManager::ChannelAnalysis::push(const float* samples, int numSamples, int hop)
+{
+	bool hasNewBlock = false;
+
+	while (numSamples > 0)
+	{
+		int num = jmin(numSamples, fftSize - fifoIndex, hop - samplesSinceLastBlock);
+		FloatVectorOperations::copy(fifo + fifoIndex, samples, num);
+
+		samples += num;
+		numSamples -= num;
+		samplesSinceLastBlock += num;
+		fifoIndex = (fifoIndex + num) % fftSize;
+
+		if (samplesSinceLastBlock < hop) continue;
+		samplesSinceLastBlock = 0;
+
+		//if the analysis thread did not consume the previous window yet, this one is dropped
+		if (blockReady) continue;
+
+		int tail = fftSize - fifoIndex;
+		FloatVectorOperations::copy(readyBlock, fifo + fifoIndex, tail);
+		FloatVectorOperations::copy(readyBlock + tail, fifo, fifoIndex);
+		blockReady = true;
+		hasNewBlock = true;
+	}
+
+	return hasNewBlock;
+}
@@ -11,7 +11,8 @@
 #pragma once
 
 class FFTAnalyzerManager :
-	public BaseManager<FFTAnalyzer>
+	public BaseManager<FFTAnalyzer>,
+	public Thread
 {
 public:
 	FFTAnalyzerManager();
@@ -20,26 +21,65 @@ public:
 
 	FloatParameter* minDB;
 	FloatParameter* maxDB;
+	EnumParameter* fftSize;
+	EnumParameter* hopSize;
 
-
-	//FFT
 	enum
 	{
-		fftOrder = 11,            // [1]
-		fftSize = 1 << fftOrder, // [2]
-		scopeSize = 256            // [3]
+		scopeSize = 256
+	};
+
+	//Per input channel analysis state.
+	//The audio thread only fills the fifo and hands over a full window, the FFT itself runs on the analysis thread.
+	class ChannelAnalysis
+	{
+	public:
+		ChannelAnalysis(int fftOrder);
+
+		int fftSize;
+		dsp::FFT fft;
+
+		HeapBlock<float> fifo; //circular, audio thread only
+		int fifoIndex;
+		int samplesSinceLastBlock;
+
+		HeapBlock<float> readyBlock; //last window, unwrapped, written by the audio thread when blockReady is false
+		std::atomic<bool> blockReady;
+		std::atomic<bool> isUsed;
+
+		HeapBlock<float> fftData; //analysis thread only
+		float scopeData[scopeSize];
+
+		bool push(const float* samples, int numSamples, int hop);
 	};
 
-	dsp::FFT forwardFFT;                  // [4]
-	dsp::WindowingFunction<float> window; // [5]
-	float fifo[fftSize];                 // [6]
-	float fftData[2 * fftSize];          // [7]
-	int fifoIndex = 0;                    // [8]
-	bool nextFFTBlockReady = false;       // [9]
-	float scopeData[scopeSize];          // [10]
+	OwnedArray<ChannelAnalysis> channels;
+	Array<FFTAnalyzer*> analyzers; //mirror of items guarded by analysisLock, so removed analyzers are never processed
+	std::unique_ptr<dsp::WindowingFunction<float>> window;
+	std::atomic<int> hopDivision;
+	int numInputChannels;
+
+	SpinLock channelsLock; //audio thread vs reconfiguration, only try-locked on the audio side
+	CriticalSection analysisLock; //analysis thread vs reconfiguration
+
+	ThreadPool pool;
+
+	float scopeData[scopeSize]; //first channel, for the editor
+
+	void setNumChannels(int numChannels);
+	void rebuildChannels();
+	void updateUsedChannels();
+
+	void process(const float* const* inputChannelData, int numChannels, int numSamples);
+	void analyzeChannel(int channelIndex);
+
+	void run() override;
+
+	void addItemInternal(FFTAnalyzer* item, var data) override;
+	void removeItemInternal(FFTAnalyzer* item) override;
 
-	void process(const float* samples, int numSamples);
-	void pushNextSampleIntoFifo(float sample);
+	void onContainerParameterChanged(Parameter* p) override;
+	void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
 
 	InspectableEditor* getEditorInternal(bool isRoot, Array<Inspectable*> inspectables = Array<Inspectable*>()) override;
-};
\ No newline at end of file
+};
@@ -0,0 +1,255 @@
+/*
+  ==============================================================================
+
+    OnsetDetector.cpp
+    Created: 19 Oct 2026 1:56:33am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+OnsetDetector::OnsetDetector() :
+	fft(fftOrder),
+	window(fftSize, dsp::WindowingFunction<float>::hann, false),
+	sampleRate(0),
+	hopRate(0),
+	sensitivity(.5f),
+	minInterval(.1f),
+	minBPM(70),
+	maxBPM(180),
+	resetRequested(false),
+	envelopeSize(0),
+	maxLagSize(0),
+	onsetCount(0),
+	beatCount(0)
+{
+	setSampleRate(44100);
+}
+
+void OnsetDetector::setSampleRate(double sr)
+{
+	if (sr <= 0 || sr == sampleRate) return;
+
+	sampleRate = sr;
+	hopRate = sampleRate / hopSize;
+
+	//6 seconds of envelope, enough to correlate lags down to 30 bpm
+	envelopeSize = (int)std::ceil(hopRate * 6);
+	maxLagSize = (int)std::ceil(hopRate * 2) + 2;
+	envelope.calloc(envelopeSize);
+	tempoBuffer.calloc(envelopeSize);
+	lagScores.calloc(maxLagSize);
+
+	reset();
+}
+
+void OnsetDetector::reset()
+{
+	FloatVectorOperations::clear(fifo, fftSize);
+	FloatVectorOperations::clear(prevMagnitudes, numBins);
+	FloatVectorOperations::clear(thresholdHistory, thresholdHistorySize);
+	if (envelopeSize > 0) FloatVectorOperations::clear(envelope.get(), envelopeSize);
+
+	fifoIndex = 0;
+	samplesSinceLastHop = 0;
+	hopCount = 0;
+	thresholdHistoryIndex = 0;
+	thresholdSum = 0;
+	prevFlux = 0;
+	prevPrevFlux = 0;
+	fluxPeak = 0;
+	lastOnsetTime = -1;
+	hopsSinceTempoUpdate = 0;
+	tempoLag = -1;
+	beatPeriod = 0;
+	lastBeatTime = -1;
+	strength = 0;
+}
+
+void OnsetDetector::process(const float* samples, int numSamples)
+{
+	if (resetRequested.exchange(false)) reset();
+
+	while (numSamples > 0)
+	{
+		int num = jmin(numSamples, fftSize - fifoIndex, hopSize - samplesSinceLastHop);
+		FloatVectorOperations::copy(fifo + fifoIndex, samples, num);
+
+		samples += num;
+		numSamples -= num;
+		samplesSinceLastHop += num;
+		fifoIndex = (fifoIndex + num) % fftSize;
+
+		if (samplesSinceLastHop < hopSize) continue;
+		samplesSinceLastHop = 0;
+		processHop();
+	}
+}
+
+float OnsetDetector::getBeatPhase() const
+{
+	if (beatPeriod <= 0 || lastBeatTime < 0) return 0;
+	double time = hopCount / hopRate;
+	return (float)jlimit(0.0, 1.0, (time - lastBeatTime) / beatPeriod);
+}
+
+void OnsetDetector::processHop()
+{
+	int tail = fftSize - fifoIndex;
+	FloatVectorOperations::copy(fftData, fifo + fifoIndex, tail);
+	FloatVectorOperations::copy(fftData + tail, fifo, fifoIndex);
+	FloatVectorOperations::clear(fftData + fftSize, fftSize);
+
+	window.multiplyWithWindowingTable(fftData, fftSize);
+	fft.performFrequencyOnlyForwardTransform(fftData);
+
+	//log compressed, half-wave rectified spectral difference
+	float flux = 0;
+	for (int i = 0; i < numBins; ++i)
+	{
+		float m = std::log1p(100.f * fftData[i]);
+		float d = m - prevMagnitudes[i];
+		if (d > 0) flux += d;
+		prevMagnitudes[i] = m;
+	}
+	flux /= numBins;
+
+	hopCount++;
+	double time = hopCount / hopRate;
+
+	envelope[(int)(hopCount % envelopeSize)] = flux;
+
+	detectOnset(flux, time);
+
+	if (tempoLag >= 0) continueTempoUpdate();
+	else if (++hopsSinceTempoUpdate >= (int)(hopRate / 2))
+	{
+		hopsSinceTempoUpdate = 0;
+		startTempoUpdate();
+	}
+
+	updateBeats(time);
+}
+
+void OnsetDetector::detectOnset(float flux, double time)
+{
+	const float peakDecay = (float)std::exp(-1.0 / (hopRate * 3));
+	fluxPeak = jmax(flux, fluxPeak * peakDecay);
+	strength = fluxPeak > 0 ? flux / fluxPeak : 0;
+
+	//the previous hop is an onset if it is a local maximum above the adaptive threshold
+	float candidate = prevFlux;
+	float mean = thresholdSum / thresholdHistorySize;
+	float threshold = mean * (1 + (1 - sensitivity.load()) * 3) + .001f;
+	double candidateTime = time - 1 / hopRate;
+
+	if (candidate > prevPrevFlux && candidate >= flux && candidate > threshold
+		&& (lastOnsetTime < 0 || candidateTime - lastOnsetTime >= minInterval.load()))
+	{
+		lastOnsetTime = candidateTime;
+		onsetCount++;
+
+		//pull the beat grid towards onsets that fall close to a predicted beat
+		if (beatPeriod > 0)
+		{
+			if (lastBeatTime < 0) lastBeatTime = candidateTime;
+			else
+			{
+				double predicted = lastBeatTime + std::round((candidateTime - lastBeatTime) / beatPeriod) * beatPeriod;
+				double error = candidateTime - predicted;
+				if (std::abs(error) < beatPeriod * .2) lastBeatTime += error * .3;
+			}
+		}
+	}
+
+	thresholdSum += candidate - thresholdHistory[thresholdHistoryIndex];
+	thresholdHistory[thresholdHistoryIndex] = candidate;
+	thresholdHistoryIndex = (thresholdHistoryIndex + 1) % thresholdHistorySize;
+
+	prevPrevFlux = prevFlux;
+	prevFlux = flux;
+}
+
+void OnsetDetector::startTempoUpdate()
+{
+	if (hopCount < envelopeSize) return;
+
+	//the envelope is frozen in tempoBuffer for the whole update
+	int n = envelopeSize;
+	int start = (int)((hopCount + 1) % envelopeSize);
+	int tail = n - start;
+	FloatVectorOperations::copy(tempoBuffer.get(), envelope.get() + start, tail);
+	FloatVectorOperations::copy(tempoBuffer.get() + tail, envelope.get(), start);
+
+	float mean = 0;
+	for (int i = 0; i < n; ++i) mean += tempoBuffer[i];
+	mean /= n;
+	FloatVectorOperations::add(tempoBuffer.get(), -mean, n);
+
+	float curMinBPM = minBPM.load();
+	float curMaxBPM = maxBPM.load();
+	float lowBPM = jmin(curMinBPM, curMaxBPM);
+	float highBPM = jmax(curMinBPM, curMaxBPM);
+	tempoMinLag = jmax(1, (int)std::floor(60 * hopRate / highBPM));
+	tempoMaxLag = jmin(maxLagSize - 2, n / 2, (int)std::ceil(60 * hopRate / lowBPM));
+	if (tempoMaxLag <= tempoMinLag + 1) return;
+
+	tempoLag = tempoMinLag - 1;
+	continueTempoUpdate();
+}
+
+void OnsetDetector::continueTempoUpdate()
+{
+	int n = envelopeSize;
+
+	//autocorrelation weighted towards 120 bpm, to favor the perceived tempo over its multiples
+	int lastLag = jmin(tempoMaxLag + 1, tempoLag + tempoLagsPerHop - 1);
+	for (; tempoLag <= lastLag; ++tempoLag)
+	{
+		float acf = 0;
+		for (int i = tempoLag; i < n; ++i) acf += tempoBuffer[i] * tempoBuffer[i - tempoLag];
+		acf /= (n - tempoLag);
+
+		double lagBPM = 60 * hopRate / tempoLag;
+		double octaves = std::log2(lagBPM / 120);
+		lagScores[tempoLag] = acf * (float)std::exp(-.5 * octaves * octaves);
+	}
+
+	if (tempoLag <= tempoMaxLag + 1) return;
+	tempoLag = -1;
+
+	int bestLag = -1;
+	float bestScore = 0;
+	for (int lag = tempoMinLag; lag <= tempoMaxLag; ++lag)
+	{
+		if (lagScores[lag] > bestScore)
+		{
+			bestScore = lagScores[lag];
+			bestLag = lag;
+		}
+	}
+
+	if (bestLag < 0) return;
+
+	//parabolic interpolation for sub-hop precision
+	float a = lagScores[bestLag - 1];
+	float b = lagScores[bestLag];
+	float c = lagScores[bestLag + 1];
+	float denom = a - 2 * b + c;
+	double lag = bestLag + (denom != 0 ? jlimit(-.5f, .5f, .5f * (a - c) / denom) : 0);
+	double period = lag / hopRate;
+
+	if (beatPeriod <= 0 || std::abs(period - beatPeriod) > beatPeriod * .15) beatPeriod = period;
+	else beatPeriod += (period - beatPeriod) * .2;
+}
+
+void OnsetDetector::updateBeats(double time)
+{
+	if (beatPeriod <= 0 || lastBeatTime < 0) return;
+
+	while (time >= lastBeatTime + beatPeriod)
+	{
+		lastBeatTime += beatPeriod;
+		beatCount++;
+	}
+}
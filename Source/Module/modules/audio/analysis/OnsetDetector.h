@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    OnsetDetector.h
+    Created: 19 Oct 2026 1:56:33am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//Spectral flux onset detector with an autocorrelation tempo tracker.
+//Runs directly in the audio callback on small hops, so an onset is reported one hop after its peak.
+class OnsetDetector
+{
+public:
+	OnsetDetector();
+	~OnsetDetector() {}
+
+	enum
+	{
+		fftOrder = 10,
+		fftSize = 1 << fftOrder,
+		numBins = fftSize / 2,
+		hopSize = 256,
+		thresholdHistorySize = 48,
+		tempoLagsPerHop = 16 //autocorrelation lags computed per hop, a tempo update is spread over ~15 hops
+	};
+
+	dsp::FFT fft;
+	dsp::WindowingFunction<float> window;
+
+	float fifo[fftSize];
+	int fifoIndex;
+	int samplesSinceLastHop;
+	float fftData[2 * fftSize];
+	float prevMagnitudes[numBins];
+
+	double sampleRate;
+	double hopRate;
+	int64 hopCount;
+
+	//settings, written from the message thread
+	std::atomic<float> sensitivity;
+	std::atomic<float> minInterval; //seconds
+	std::atomic<float> minBPM;
+	std::atomic<float> maxBPM;
+	std::atomic<bool> resetRequested;
+
+	//onset
+	float thresholdHistory[thresholdHistorySize];
+	int thresholdHistoryIndex;
+	float thresholdSum;
+	float prevFlux;
+	float prevPrevFlux;
+	float fluxPeak;
+	double lastOnsetTime;
+
+	//tempo
+	HeapBlock<float> envelope; //flux history, circular
+	HeapBlock<float> tempoBuffer;
+	HeapBlock<float> lagScores;
+	int envelopeSize;
+	int maxLagSize;
+	int hopsSinceTempoUpdate;
+	int tempoLag; //next lag of the running autocorrelation, -1 when idle
+	int tempoMinLag;
+	int tempoMaxLag;
+	double beatPeriod; //seconds, 0 until a tempo is found
+	double lastBeatTime;
+
+	//results, read by the audio module after process()
+	float strength;
+	int onsetCount;
+	int beatCount;
+
+	void setSampleRate(double sampleRate); //only while the audio callback is stopped
+	void reset();
+	void requestReset() { resetRequested = true; } //from any thread, applied on the next process()
+
+	void process(const float* samples, int numSamples);
+
+	float getBPM() const { return beatPeriod > 0 ? (float)(60.0 / beatPeriod) : 0; }
+	float getBeatPhase() const;
+
+private:
+	void processHop();
+	void detectOnset(float flux, double time);
+	void startTempoUpdate();
+	void continueTempoUpdate();
+	void updateBeats(double time);
+
+	JUCE_DECLARE_NON_COPYABLE(OnsetDetector)
+};
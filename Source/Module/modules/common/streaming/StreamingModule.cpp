@@ -130,7 +130,7 @@ void StreamingModule::processDataLine(const String& msg)
 
 	processDataLineInternal(message);
 
-	scriptManager->callFunctionOnAllItems(dataEventId, message);
+	if (hasScriptCallback(dataEventId)) scriptManager->callFunctionOnAllItems(dataEventId, message);
 
 	MessageStructure s = messageStructure->getValueDataAsEnum<MessageStructure>();
 	StringArray valuesString;
@@ -323,7 +323,7 @@ void StreamingModule::processDataBytes(Array<uint8_t> data)
 
 	processDataBytesInternal(data);
 
-	if (scriptManager->items.size() > 0)
+	if (hasScriptCallback(dataEventId))
 	{
 		var args;
 		for (auto& d : data) args.append(d);
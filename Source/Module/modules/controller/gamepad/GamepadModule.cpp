@@ -60,7 +60,14 @@ void GamepadModule::setGamepad(Gamepad* g)
 	gamepad = g;
 	gamepadRef = g;
 
-	if (gamepad != nullptr) gamepad->addGamepadListener(this);
+	if (gamepad != nullptr)
+	{
+		gamepad->addGamepadListener(this);
+
+		//Only changes are dispatched, so sync with the current state of the device
+		for (int i = 0; i < gamepad->axisValues.size(); ++i) updateAxis(i, gamepad->getAxisValue(i));
+		for (int i = 0; i < gamepad->buttonValues.size() && i < buttonsCC.controllables.size(); ++i) ((BoolParameter*)buttonsCC.controllables[i])->setValue(gamepad->getButtonValue(i));
+	}
 }
 
 void GamepadModule::gamepadAdded(Gamepad* g)
@@ -75,28 +82,40 @@ void GamepadModule::gamepadRemoved(Gamepad* g)
 	if (g == gamepad) gamepadParam->setGamepad(nullptr);
 }
 
-void GamepadModule::gamepadValuesUpdated(Array<float> axes, Array<bool> buttons)
+void GamepadModule::updateAxis(int index, float rawValue)
 {
-	for (int i = 0; i < axes.size() && i < axesCC.controllables.size(); ++i)
-	{
-		float axisValue = jmap<float>(axes[i], INT16_MIN, INT16_MAX, -1, 1) + axisOffset[i]->floatValue();
-		if (fabs(axisValue) < axisDeadzone[i]->floatValue()) axisValue = 0;
-		else
-		{
-			if (axisValue > 0) axisValue = jmap<float>(axisValue, axisDeadzone[i]->floatValue(), 1 + axisOffset[i]->floatValue(), 0, 1);
-			else axisValue = jmap<float>(axisValue, -1 + axisOffset[i]->floatValue(), -axisDeadzone[i]->floatValue(), -1, 0);
-		}
-		((FloatParameter*)axesCC.controllables[i])->setValue(axisValue);
-	}
+	if (!isPositiveAndBelow(index, axesCC.controllables.size())) return;
 
-	for (int i = 0; i < SDL_CONTROLLER_BUTTON_MAX; ++i)
+	float axisValue = jmap<float>(rawValue, INT16_MIN, INT16_MAX, -1, 1) + axisOffset[index]->floatValue();
+	if (fabs(axisValue) < axisDeadzone[index]->floatValue()) axisValue = 0;
+	else
 	{
-		((BoolParameter*)buttonsCC.controllables[i])->setValue(buttons[i]);
+		if (axisValue > 0) axisValue = jmap<float>(axisValue, axisDeadzone[index]->floatValue(), 1 + axisOffset[index]->floatValue(), 0, 1);
+		else axisValue = jmap<float>(axisValue, -1 + axisOffset[index]->floatValue(), -axisDeadzone[index]->floatValue(), -1, 0);
 	}
+	((FloatParameter*)axesCC.controllables[index])->setValue(axisValue);
+}
+
+void GamepadModule::gamepadAxisChanged(Gamepad* g, int index, float value, uint32 timestamp)
+{
+	updateAxis(index, value);
+}
+
+void GamepadModule::gamepadButtonChanged(Gamepad* g, int index, bool value, uint32 timestamp)
+{
+	if (!isPositiveAndBelow(index, buttonsCC.controllables.size())) return;
+	((BoolParameter*)buttonsCC.controllables[index])->setValue(value);
 }
 
 void GamepadModule::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c)
 {
 	Module::onControllableFeedbackUpdateInternal(cc, c);
 	if (c == gamepadParam) setGamepad(gamepadParam->gamepad);
+	else if (gamepad != nullptr && !gamepadRef.wasObjectDeleted())
+	{
+		//Values are not polled anymore, re-apply calibration on the last known raw value
+		int index = axisOffset.indexOf((FloatParameter*)c);
+		if (index == -1) index = axisDeadzone.indexOf((FloatParameter*)c);
+		if (isPositiveAndBelow(index, gamepad->axisValues.size())) updateAxis(index, gamepad->getAxisValue(index));
+	}
 }
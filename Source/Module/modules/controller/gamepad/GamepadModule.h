@@ -37,7 +37,9 @@ public:
 	void gamepadAdded(Gamepad *) override;
 	void gamepadRemoved(Gamepad *) override;
 
-	void gamepadValuesUpdated(Array<float> axes, Array<bool> buttons) override;
+	void updateAxis(int index, float rawValue);
+	void gamepadAxisChanged(Gamepad* g, int index, float value, uint32 timestamp) override;
+	void gamepadButtonChanged(Gamepad* g, int index, bool value, uint32 timestamp) override;
 
 	void onControllableFeedbackUpdateInternal(ControllableContainer * cc, Controllable * c) override;
 
@@ -17,7 +17,9 @@ DMXModule::DMXModule() :
 	Thread("DMX Send"),
 	dmxDevice(nullptr),
 	inputUniverseManager(true),
-	outputUniverseManager(false)
+	outputUniverseManager(false),
+	recorderCC("Recorder"),
+	isUpdatingReplayTime(false)
 {
 	setupIOConfiguration(false, true);
 
@@ -82,12 +84,39 @@ DMXModule::DMXModule() :
 	thruManager->customUserCreateControllableFunc = &DMXModule::createThruControllable;
 	moduleParams.addChildControllableContainer(thruManager.get());
 
+	recorderCC.editorIsCollapsed = true;
+	recordingFile = recorderCC.addFileParameter("File", "The file to record incoming DMX to, or to replay from");
+	isRecording = recorderCC.addBoolParameter("Record", "When enabled, all incoming universes are recorded to the file", false);
+	isReplaying = recorderCC.addBoolParameter("Replay", "When enabled, the recorded file is played back as if it was received by the device", false);
+	replayLoop = recorderCC.addBoolParameter("Loop", "Restart the replay when the end of the file is reached", false);
+	replayTime = recorderCC.addFloatParameter("Replay Time", "Current time of the replay, change it to seek", 0, 0);
+	replayTime->defaultUI = FloatParameter::TIME;
+	isRecording->isSavable = false;
+	isReplaying->isSavable = false;
+	moduleParams.addChildControllableContainer(&recorderCC);
+
+	replayTimeSlot = ParameterPublisher::getInstance()->addSlot(replayTime, ParameterPublisher::MESSAGE_THREAD);
+	replayTimeSlot->applyFunc = [this](const double* v, int, double)
+	{
+		//not a user seek
+		isUpdatingReplayTime = true;
+		replayTime->setValue(v[0]);
+		isUpdatingReplayTime = false;
+	};
+
 	inputUniverseManager.addBaseManagerListener(this);
 	outputUniverseManager.addBaseManagerListener(this);
 }
 
 DMXModule::~DMXModule()
 {
+	replayer.reset();
+	{
+		GenericScopedLock lock(recorderLock);
+		recorder.reset();
+	}
+
+	if (ParameterPublisher* publisher = ParameterPublisher::getInstanceWithoutCreating()) publisher->removeSlot(replayTimeSlot);
 }
 
 void DMXModule::itemAdded(DMXUniverse* i)
@@ -113,7 +142,10 @@ void DMXModule::setCurrentDMXDevice(DMXDevice* d)
 		moduleParams.removeChildControllableContainer(dmxDevice.get());
 	}
 
-	dmxDevice.reset(d);
+	{
+		GenericScopedLock lock(deviceLock); //the replayer may be feeding the previous device
+		dmxDevice.reset(d);
+	}
 
 	//dmxConnected->hideInEditor = dmxDevice == nullptr || dmxDevice->type == DMXDevice::ARTNET;
 	dmxConnected->setValue(false);
@@ -159,6 +191,62 @@ void DMXModule::updateDeviceMulticast()
 	dmxDevice->setupMulticast(inUniv, outUniv);
 }
 
+void DMXModule::updateRecorder()
+{
+	std::unique_ptr<DMXRecorder> newRecorder;
+
+	if (isRecording->boolValue())
+	{
+		if (recordingFile->stringValue().isEmpty())
+		{
+			NLOGWARNING(niceName, "No file set to record to");
+			isRecording->setValue(false);
+			return;
+		}
+
+		if (isReplaying->boolValue()) isReplaying->setValue(false);
+		newRecorder.reset(new DMXRecorder(recordingFile->getFile()));
+		NLOG(niceName, "Recording incoming DMX to " << recordingFile->getFile().getFullPathName());
+	}
+
+	{
+		GenericScopedLock lock(recorderLock);
+		recorder.swap(newRecorder);
+	}
+
+	//previous recorder is flushed and closed here, outside of the lock
+	newRecorder.reset();
+}
+
+void DMXModule::updateReplayer()
+{
+	replayer.reset();
+
+	if (!isReplaying->boolValue()) return;
+
+	File f = recordingFile->getFile();
+	if (!f.existsAsFile())
+	{
+		NLOGWARNING(niceName, "DMX recording file not found : " << f.getFullPathName());
+		isReplaying->setValue(false);
+		return;
+	}
+
+	if (isRecording->boolValue()) isRecording->setValue(false);
+
+	replayer.reset(new DMXReplayer(f, this));
+	if (replayer->data == nullptr)
+	{
+		//the replayer already logged why the file could not be mapped
+		replayer.reset();
+		isReplaying->setValue(false);
+		return;
+	}
+
+	replayer->loop = replayLoop->boolValue();
+	if (replayTime->floatValue() > 0) replayer->seek(replayTime->floatValue());
+}
+
 void DMXModule::sendDMXValue(DMXUniverse* u, int channel, uint8 value)
 {
 	if (!enabled->boolValue()) return;
@@ -267,6 +355,11 @@ var DMXModule::sendDMXFromScript(const var::NativeFunctionArgs& args)
 void DMXModule::clearItem()
 {
 	BaseItem::clearItem();
+	replayer.reset();
+	{
+		GenericScopedLock lock(recorderLock);
+		recorder.reset();
+	}
 	setCurrentDMXDevice(nullptr);
 }
 
@@ -350,6 +443,16 @@ void DMXModule::controllableFeedbackUpdate(ControllableContainer* cc, Controllab
 {
 	Module::controllableFeedbackUpdate(cc, c);
 	if (c == dmxType) setCurrentDMXDevice(DMXDevice::create((DMXDevice::Type)(int)dmxType->getValueData()));
+	else if (c == isRecording) updateRecorder();
+	else if (c == isReplaying) updateReplayer();
+	else if (c == replayLoop)
+	{
+		if (replayer != nullptr) replayer->loop = replayLoop->boolValue();
+	}
+	else if (c == replayTime)
+	{
+		if (replayer != nullptr && !isUpdatingReplayTime) replayer->seek(replayTime->floatValue());
+	}
 	else if (dmxDevice != nullptr)
 	{
 		if (c == dmxDevice->outputCC->enabled || (dmxDevice->canReceive && (c == dmxDevice->inputCC->enabled)))
@@ -376,6 +479,13 @@ void DMXModule::dmxDeviceDisconnected()
 void DMXModule::dmxDataInChanged(int net, int subnet, int universe, Array<uint8> values, const String& sourceName)
 {
 	if (isClearing || !enabled->boolValue()) return;
+
+	if (sourceName != replaySourceName)
+	{
+		GenericScopedLock lock(recorderLock);
+		if (recorder != nullptr) recorder->addFrame(net, subnet, universe, values.getRawDataPointer());
+	}
+
 	if (logIncomingData->boolValue())
 	{
 		String s = "DMX In received :\nNet : " + String(net) + "\nSubnet : " + String(subnet) + "\nUniverse : " + String(universe);
@@ -409,7 +519,7 @@ void DMXModule::dmxDataInChanged(int net, int subnet, int universe, Array<uint8>
 
 	u->updateValues(values);
 
-	if (scriptManager->items.size() > 0)
+	if (hasScriptCallback(dmxEventId))
 	{
 		Array<var> args;
 		args.add(net);
@@ -437,6 +547,28 @@ DMXUniverse* DMXModule::getUniverse(bool isInput, int net, int subnet, int unive
 	return m->addItem(u);
 }
 
+void DMXModule::replayFrame(int net, int subnet, int universe, const uint8* values)
+{
+	GenericScopedLock lock(deviceLock);
+	if (dmxDevice != nullptr) dmxDevice->setDMXValuesIn(net, subnet, universe, Array<uint8>(values, DMX_NUM_CHANNELS), replaySourceName);
+}
+
+void DMXModule::replayTimeChanged(double time)
+{
+	replayTimeSlot->publish(time);
+}
+
+void DMXModule::replayFinished()
+{
+	WeakReference<Inspectable> moduleRef(this);
+	MessageManager::callAsync([this, moduleRef]()
+		{
+			if (moduleRef.wasObjectDeleted()) return;
+			isReplaying->setValue(false);
+		}
+	);
+}
+
 void DMXModule::run()
 {
 	while (!threadShouldExit())
@@ -14,6 +14,7 @@ class DMXModule :
 	public Module,
 	public DMXDevice::DMXDeviceListener,
 	public DMXUniverseManager::ManagerListener,
+	public DMXReplayer::ReplayerListener,
 	public Thread
 {
 public:
@@ -44,6 +45,21 @@ public:
 	DMXUniverseManager inputUniverseManager;
 	DMXUniverseManager outputUniverseManager;
 
+	//Recording
+	ControllableContainer recorderCC;
+	FileParameter* recordingFile;
+	BoolParameter* isRecording;
+	BoolParameter* isReplaying;
+	BoolParameter* replayLoop;
+	FloatParameter* replayTime;
+
+	SpinLock recorderLock; //recorder is fed from the device receive thread
+	std::unique_ptr<DMXRecorder> recorder;
+	std::unique_ptr<DMXReplayer> replayer;
+	ParameterPublisher::Slot* replayTimeSlot;
+	bool isUpdatingReplayTime;
+	const String replaySourceName = "Replay";
+
 
 	void itemAdded(DMXUniverse* i) override;
 	void itemRemoved(DMXUniverse* i) override;
@@ -53,6 +69,9 @@ public:
 
 	void updateDeviceMulticast();
 
+	void updateRecorder();
+	void updateReplayer();
+
 	void sendDMXValue(DMXUniverse* u, int channel, uint8 value);
 	void sendDMXRange(DMXUniverse* u, int startChannel, Array<uint8> values);
 	void send16BitDMXValue(DMXUniverse* u, int channel, int value, DMXByteOrder byteOrder);
@@ -78,6 +97,10 @@ public:
 
 	DMXUniverse* getUniverse(bool isInput, int net, int subnet, int universe, bool createIfNotThere = true);
 
+	void replayFrame(int net, int subnet, int universe, const uint8* values) override;
+	void replayTimeChanged(double time) override;
+	void replayFinished() override;
+
 	void run() override;
 
 	static void createThruControllable(ControllableContainer* cc);
@@ -12,7 +12,12 @@
 MetronomeModule::MetronomeModule() :
 	Module(getTypeString()),
 	Thread("Metronome"),
-	freqTimeBpm(nullptr)
+	freqTimeBpm(nullptr),
+	tempoChanged(false),
+	anchorTime(0),
+	tickPeriod(1000),
+	tickIndex(0),
+	beatCount(0)
 {
 	setupIOConfiguration(true, false);
 
@@ -25,10 +30,19 @@ MetronomeModule::MetronomeModule() :
 	tapTempoIntervalsMax = moduleParams.addIntParameter("Tap tempo averaging", "How many intervals do you want to use in averaging ? 0 means all",4,1);
 	tapTempo = moduleParams.addTrigger("Tap Tempo", "press me at least twice to set tempo");
 
+	beatOutputs = moduleParams.addBoolParameter("Beat Outputs", "If checked, the metronome also outputs its beat and bar counters and the current beat phase", false);
+	beatsPerBar = moduleParams.addIntParameter("Beats per bar", "Number of beats in a bar, for the beat and bar counters", 4, 1);
+
 	tick = valuesCC.addBoolParameter("Tick", "When the metronome is ticking", false);
+	beat = valuesCC.addIntParameter("Beat", "The current beat in the bar, starting at 1", 0, 0);
+	bar = valuesCC.addIntParameter("Bar", "The current bar, starting at 1 when the metronome starts", 0, 0);
+	beatPhase = valuesCC.addFloatParameter("Beat Phase", "Position inside the current beat, from 0 on the tick to 1 just before the next one", 0, 0, 1);
 
 	for (auto &c : valuesCC.controllables) c->isControllableFeedbackOnly = true;
 
+	phaseSlot = ParameterPublisher::getInstance()->addSlot(beatPhase);
+
+	updateBeatOutputs();
 	updateFreqParam();
 
 	startThread();
@@ -37,6 +51,7 @@ MetronomeModule::MetronomeModule() :
 MetronomeModule::~MetronomeModule()
 {
 	stopThread(1000);
+	if (ParameterPublisher* publisher = ParameterPublisher::getInstanceWithoutCreating()) publisher->removeSlot(phaseSlot);
 }
 
 void MetronomeModule::updateFreqParam()
@@ -72,6 +87,14 @@ void MetronomeModule::updateFreqParam()
 	startThread();
 }
 
+void MetronomeModule::updateBeatOutputs()
+{
+	beat->hideInEditor = !beatOutputs->boolValue();
+	bar->hideInEditor = !beatOutputs->boolValue();
+	beatPhase->hideInEditor = !beatOutputs->boolValue();
+	valuesCC.queuedNotifier.addMessage(new ContainerAsyncEvent(ContainerAsyncEvent::ControllableContainerNeedsRebuild, &valuesCC));
+}
+
 void MetronomeModule::onContainerParameterChangedInternal(Parameter* p)
 {
 	Module::onContainerParameterChangedInternal(p);
@@ -90,12 +113,42 @@ void MetronomeModule::onControllableFeedbackUpdateInternal(ControllableContainer
 	if (c == freqTimeBpm || c == random || c == mode)
 	{
 		if (c == mode) updateFreqParam();
+		tempoChanged = true;
 		notify(); //forces the thread to update
 	} 
 	else if (c == tapTempo)
 	{
 		tapTempoPressed();
 	}
+	else if (c == beatOutputs)
+	{
+		updateBeatOutputs();
+	}
+}
+
+double MetronomeModule::getTickPeriod(Random& r)
+{
+	double freq = 1;
+
+	MetroMode m = mode->getValueDataAsEnum<MetroMode>();
+	switch (m)
+	{
+	case FREQUENCY:
+		freq = freqTimeBpm->floatValue();
+		break;
+
+	case TIME:
+		freq = 1.0 / freqTimeBpm->floatValue();
+		break;
+
+	case BPM:
+		freq = freqTimeBpm->floatValue() / 60.0;
+		break;
+	}
+
+	if (random->floatValue() > 0) freq += (r.nextFloat() * 2 - 1) * random->floatValue();
+
+	return 1000.0 / jmax(freq, .0001);
 }
 
 void MetronomeModule::run()
@@ -103,56 +156,106 @@ void MetronomeModule::run()
 	if (!enabled->boolValue()) return;
 
 	Random r;
+
+	//ticks are placed on an absolute timeline instead of chaining relative waits, so late wake-ups never add up
+	tempoChanged = false;
+	tickPeriod = getTickPeriod(r);
+	anchorTime = Time::getMillisecondCounterHiRes();
+	tickIndex = 0;
+	beatCount = 0;
+
+	bool isOn = false;
+
 	while (!threadShouldExit())
-	{	
+	{
+		if (tempoChanged.exchange(false))
+		{
+			//keep the phase inside the current beat and continue from there at the new period
+			double now = Time::getMillisecondCounterHiRes();
+			double lastTickTime = anchorTime + (tickIndex - 1) * tickPeriod;
+			double phase = tickIndex > 0 ? jlimit(0.0, 1.0, (now - lastTickTime) / tickPeriod) : 0;
+
+			tickPeriod = getTickPeriod(r);
+			anchorTime = now - phase * tickPeriod;
+			if (tickIndex > 0) tickIndex = 1;
+		}
 
-		float freq = 1;
-		
-		MetroMode m = mode->getValueDataAsEnum<MetroMode>();
-		switch (m)
+		if (!isOn && tickIndex > 0)
 		{
-		case FREQUENCY:
-			freq = freqTimeBpm->floatValue();
-			break;
+			//after a stall, skip the ticks that are long past instead of firing them back to back
+			double now = Time::getMillisecondCounterHiRes();
+			if (now - (anchorTime + tickIndex * tickPeriod) > tickPeriod)
+			{
+				int64 nextTickIndex = (int64)std::floor((now - anchorTime) / tickPeriod) + 1;
+				beatCount += nextTickIndex - tickIndex;
+				tickIndex = nextTickIndex;
+			}
+		}
 
-		case TIME:
-			freq = 1.0f / freqTimeBpm->floatValue();
-			break;
+		double lastTickTime = anchorTime + (tickIndex - 1) * tickPeriod;
+		double target = isOn ? lastTickTime + tickPeriod * onTime->floatValue() : anchorTime + tickIndex * tickPeriod;
 
-		case BPM:
-			freq = freqTimeBpm->floatValue() / 60.f;
-			break;
-		}
+		if (!waitUntil(target)) continue;
 
-		if(random->floatValue() > 0) freq += (r.nextFloat() * 2 - 1) * random->floatValue();
+		if (isOn)
+		{
+			//off phase
+			tick->setValue(false);
+			isOn = false;
+			continue;
+		}
 
 		//on phase
-		int msBeforeON  = Time::getMillisecondCounter();
+		if (beatOutputs->boolValue())
+		{
+			int numBeats = beatsPerBar->intValue();
+			beat->setValue((int)(beatCount % numBeats) + 1);
+			bar->setValue((int)(beatCount / numBeats) + 1);
+			phaseSlot->publish(0);
+		}
+		beatCount++;
+
 		tick->setValue(true);
 		inActivityTrigger->trigger();
-		int msONDiff = Time::getMillisecondCounter() - msBeforeON;
-
-		int msToOff = (1000 / freq) * onTime->floatValue();
-
-		int realMSToOff = msToOff - msONDiff;
+		isOn = true;
 
-		if (realMSToOff > 0)
+		if (random->floatValue() > 0)
 		{
-			bool hasBeenSignalled = wait(realMSToOff);
-			if (hasBeenSignalled) continue;
+			//every beat gets its own period, starting from where this one was due
+			anchorTime = target;
+			tickPeriod = getTickPeriod(r);
+			tickIndex = 1;
 		}
+		else
+		{
+			tickIndex++;
+		}
+	}
+}
 
-		//off phase
-		int msBeforeOFF = Time::getMillisecondCounter();
-		tick->setValue(false);
-		int msOFFDiff = Time::getMillisecondCounter() - msBeforeOFF;
+bool MetronomeModule::waitUntil(double targetMillis)
+{
+	//coarse sleep, then yield for the last millisecond to get sub-millisecond precision on the tick
+	while (!threadShouldExit() && !tempoChanged)
+	{
+		double now = Time::getMillisecondCounterHiRes();
+		if (beatOutputs->boolValue()) publishPhase(now);
 
-		int msToOn = (1000 / freq) * (1 - onTime->floatValue());
-		int realMSToOn = msToOn - msOFFDiff;
+		double remaining = targetMillis - now;
+		if (remaining <= 0) return true;
 
-		if (realMSToOn > 0) wait(realMSToOn);
+		if (remaining > 2) wait(jmin((int)remaining - 1, beatOutputs->boolValue() ? 15 : INT_MAX));
+		else Thread::yield();
 	}
-	
+
+	return false;
+}
+
+void MetronomeModule::publishPhase(double now)
+{
+	if (tickIndex == 0) return;
+	double lastTickTime = anchorTime + (tickIndex - 1) * tickPeriod;
+	phaseSlot->publish(jlimit(0.0, 1.0, (now - lastTickTime) / tickPeriod));
 }
 
 void MetronomeModule::tapTempoPressed()
@@ -19,6 +19,9 @@ public:
 	~MetronomeModule();
 
 	BoolParameter * tick;
+	IntParameter* beat;
+	IntParameter* bar;
+	FloatParameter* beatPhase;
 
 
 	enum MetroMode { FREQUENCY, TIME, BPM };
@@ -31,7 +34,23 @@ public:
 	Random rnd;
 	Array<double> tapTempoHistory;
 	IntParameter* tapTempoIntervalsMax;
+	BoolParameter* beatOutputs;
+	IntParameter* beatsPerBar;
+
+	ParameterPublisher::Slot* phaseSlot;
+	std::atomic<bool> tempoChanged;
+
+	//metronome thread only, tick n is due at anchorTime + n * tickPeriod
+	double anchorTime;
+	double tickPeriod;
+	int64 tickIndex;
+	int64 beatCount;
+
 	void updateFreqParam();
+	void updateBeatOutputs();
+	double getTickPeriod(Random& r);
+	bool waitUntil(double targetMillis);
+	void publishPhase(double now);
 	
 	void onContainerParameterChangedInternal(Parameter* p) override;
 	void onControllableFeedbackUpdateInternal(ControllableContainer * cc, Controllable * c) override;
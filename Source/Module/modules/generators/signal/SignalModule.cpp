@@ -13,6 +13,8 @@ SignalModule::SignalModule() :
 	Module(getTypeString()),
 	Thread("Signal"),
 	progression(0),
+	resetRequested(false),
+	numSignalValues(0),
 	value(nullptr),
 	curRandom(0),
 	prevRandomProg(0)
@@ -44,6 +46,8 @@ SignalModule::SignalModule() :
 
 	for (auto& c : valuesCC.controllables) c->isControllableFeedbackOnly = true;
 
+	createOffsetValues();
+
 	startThread();
 }
 
@@ -97,11 +101,13 @@ void SignalModule::onControllableFeedbackUpdateInternal(ControllableContainer* c
 	}
 	else if (c == offsetsNumber)
 	{
+		stopThread(1000);
 		createOffsetValues();
+		if (enabled->boolValue()) startThread();
 	}
 	else if (c == resetTrigger)
 	{
-		progression = 0;
+		resetRequested = true;
 	}
 	else if (c == tapTempo)
 	{
@@ -113,49 +119,37 @@ void SignalModule::run()
 {
 	if (!enabled->boolValue()) return;
 
-	int lastUpdateMS = Time::getMillisecondCounter();
+	//progression is integrated from the hi-res clock and every output is sampled at that same instant, so offsets stay in phase
+	double lastUpdateTime = Time::getMillisecondCounterHiRes();
+	double nextUpdateTime = lastUpdateTime;
+
+	for (int i = 0; i < numSignalValues; i++) lastValues[i] = -1;
 
 	while (!threadShouldExit())
 	{
-		int curTime = Time::getMillisecondCounter();
+		double curTime = Time::getMillisecondCounterHiRes();
+
+		if (resetRequested.exchange(false)) progression = 0;
 
 		if (frequency->floatValue() > 0)
 		{
-			SignalType t = type->getValueDataAsEnum<SignalType>();
-
-			float progWithPhaseOffset = progression + phaseOffset->floatValue();
-
-			float val = getValueFromProgression(t, progWithPhaseOffset);
-
-			int nOffsets = offsetsNumber->getValue();
-			if (nOffsets > 0) {
-				float delta = offsetCycles->getValue();
-				delta /= nOffsets + 1;
-
-				for (int i = 0; i < nOffsets; i++) {
-					float offset = delta * (i + 1);
-					offset = progWithPhaseOffset - offset;
-					float v = getValueFromProgression(t, offset, i + 1);
-					if (offsetValues.size() > i) {
-						offsetValues[i]->setNormalizedValue(v);
-					}
-				}
-			}
-
-			int msDiff = curTime - lastUpdateMS;
-			progression += msDiff * frequency->floatValue() / 1000.0f;
+			int numValues = jmin(numSignalValues, offsetValues.size() + 1);
+			computeValues(type->getValueDataAsEnum<SignalType>(), progression + phaseOffset->floatValue(), numValues);
+			applyValues(numValues);
 
-
-			value->setNormalizedValue(val);
-			inActivityTrigger->trigger();
+			progression += (curTime - lastUpdateTime) * frequency->floatValue() / 1000.0;
 		}
 
-		lastUpdateMS = curTime;
+		lastUpdateTime = curTime;
+
+		//updates are due on a fixed grid rather than after each pass, only resyncing if we fell a whole interval behind
+		double interval = 1000.0 / refreshRate->floatValue();
+		nextUpdateTime += interval;
+		double now = Time::getMillisecondCounterHiRes();
+		if (nextUpdateTime < now - interval) nextUpdateTime = now;
 
-		int waitMS = 1000.0f / refreshRate->floatValue();
-		int afterProcessDiff = Time::getMillisecondCounter() - curTime;
-		int realMSToWait = jmax(0, waitMS - afterProcessDiff);
-		wait(realMSToWait);
+		int msToWait = (int)(nextUpdateTime - now);
+		if (msToWait > 0) wait(msToWait);
 	}
 }
 
@@ -179,54 +173,82 @@ void SignalModule::createOffsetValues()
 		}
 	}
 
-	curRandom.resize(asked);
-	prevRandomProg.resize(asked);
+	numSignalValues = asked + 1;
+	progressions.malloc(numSignalValues);
+	signalValues.malloc(numSignalValues);
+	lastValues.malloc(numSignalValues);
+	for (int i = 0; i < numSignalValues; i++) lastValues[i] = -1;
 
+	curRandom.resize(numSignalValues);
+	prevRandomProg.resize(numSignalValues);
 }
 
-float SignalModule::getValueFromProgression(SignalType t, float prog, int offsetIndex) {
-	float val = 0;
+void SignalModule::computeValues(SignalType t, double prog, int numValues)
+{
+	//offsets are spread behind the main value over the requested number of cycles
+	double delta = numValues > 1 ? offsetCycles->floatValue() / numValues : 0;
+	for (int i = 0; i < numValues; i++) progressions[i] = prog - delta * i;
+
+	//one tight loop per type, wrapping in double so precision doesn't degrade as progression grows
 	switch (t)
 	{
 	case SINE:
-		val = sinf(prog * MathConstants<float>::pi * 2) * .5f + .5f;
+		for (int i = 0; i < numValues; i++) signalValues[i] = (float)(std::sin((progressions[i] - std::floor(progressions[i])) * MathConstants<double>::twoPi) * .5 + .5);
 		break;
 
 	case TRIANGLE:
-		val = fabsf(fmodf(prog, 2) - 1);
+		for (int i = 0; i < numValues; i++) signalValues[i] = (float)std::abs(progressions[i] - std::floor(progressions[i] / 2) * 2 - 1);
 		break;
 
 	case SAW:
-		val = fmodf(prog, 1);
+		for (int i = 0; i < numValues; i++) signalValues[i] = (float)(progressions[i] - std::floor(progressions[i]));
 		break;
 
 	case SAW_REVERSE:
-		val = 1 - fmodf(prog, 1);
+		for (int i = 0; i < numValues; i++) signalValues[i] = (float)(1 - (progressions[i] - std::floor(progressions[i])));
 		break;
 
 	case RANDOM:
-	{
-		int floorProg = floorf(prog);
-		if (floorProg != prevRandomProg[offsetIndex])
+		for (int i = 0; i < numValues; i++)
 		{
-			curRandom.set(offsetIndex, random.nextFloat());
-			prevRandomProg.set(offsetIndex, floorProg);
+			int floorProg = (int)std::floor(progressions[i]);
+			if (floorProg != prevRandomProg[i])
+			{
+				curRandom.set(i, random.nextFloat());
+				prevRandomProg.set(i, floorProg);
+			}
+			signalValues[i] = curRandom[i];
 		}
-		val = curRandom[offsetIndex];
-	}
-	break;
+		break;
 
 	case PERLIN:
-		val = perlin.octaveNoise0_1(prog, octaves->intValue());
-		break;
+	{
+		int numOctaves = octaves->intValue();
+		for (int i = 0; i < numValues; i++) signalValues[i] = (float)perlin.octaveNoise0_1(progressions[i], numOctaves);
+	}
+	break;
 
 	case CUSTOM:
-		if (customCurve != nullptr) {
-			val = customCurve->getValueAtPosition(fmodf(prog, 1));
-		}
+		for (int i = 0; i < numValues; i++) signalValues[i] = customCurve != nullptr ? customCurve->getValueAtPosition((float)(progressions[i] - std::floor(progressions[i]))) : 0;
 		break;
 	}
-	return val;
+}
+
+void SignalModule::applyValues(int numValues)
+{
+	//all outputs are pushed back to back for the same instant, and outputs that didn't move (random, held curves) notify nobody
+	bool changed = false;
+	for (int i = 0; i < numValues; i++)
+	{
+		if (signalValues[i] == lastValues[i]) continue;
+		lastValues[i] = signalValues[i];
+		changed = true;
+
+		FloatParameter* p = i == 0 ? value : offsetValues[i - 1];
+		p->setNormalizedValue(signalValues[i]);
+	}
+
+	if (changed) inActivityTrigger->trigger();
 }
 
 
@@ -22,7 +22,8 @@ public:
 
 	enum SignalType { SINE, SAW, SAW_REVERSE, TRIANGLE, PERLIN, RANDOM, CUSTOM };
 
-	float progression;
+	double progression; //in cycles, signal thread only
+	std::atomic<bool> resetRequested;
 
 	EnumParameter * type;
 	FloatParameter * refreshRate;
@@ -36,6 +37,12 @@ public:
 	FloatParameter * offsetCycles;
 	Array<FloatParameter *> offsetValues;
 
+	//one slot per output, main value first, filled in a single pass for all of them
+	HeapBlock<double> progressions;
+	HeapBlock<float> signalValues;
+	HeapBlock<float> lastValues;
+	int numSignalValues;
+
 	FloatParameter * value;
 	
 	//Perlin
@@ -71,5 +78,6 @@ public:
 	// Inherited via Timer
 	virtual void run() override;
 
-	float getValueFromProgression(SignalType t, float prog, int offsetIndex = 0);
+	void computeValues(SignalType t, double prog, int numValues);
+	void applyValues(int numValues);
 };
\ No newline at end of file
@@ -86,6 +86,7 @@ MIDIModule::MIDIModule(const String& name, bool _useGenericControls) :
 	valuesCC.addChildControllableContainer(&infoCC);
 
 	bpm = tempoCC.addFloatParameter("BPM", "BPM detected by the incoming MIDI Clock", 0, 0, 999);
+	bpmSlot = ParameterPublisher::getInstance()->addSlot(bpm);
 	sendClock = tempoCC.addBoolParameter("Send Clock", "If checked, send MIDI Clock to the output. If not, receiving incoming MIDI Clock", false);
 	midiStartTrigger = tempoCC.addTrigger("Start", "Clock Start signal");
 	midiStopTrigger = tempoCC.addTrigger("Stop", "Clock Stop signal");
@@ -111,6 +112,7 @@ MIDIModule::~MIDIModule()
 {
 	if (inputDevice != nullptr) inputDevice->removeMIDIInputListener(this);
 	if (outputDevice != nullptr) outputDevice->close();
+	if (ParameterPublisher* publisher = ParameterPublisher::getInstanceWithoutCreating()) publisher->removeSlot(bpmSlot);
 }
 
 
@@ -535,7 +537,7 @@ void MIDIModule::midiClockReceived()
 		if (quarterNoteDiff > 0)
 		{
 			double targetBPM = 60.0 / quarterNoteDiff;
-			bpm->setValue(targetBPM);
+			bpmSlot->publish(targetBPM);
 		}
 	}
 
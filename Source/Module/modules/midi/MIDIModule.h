@@ -85,6 +85,7 @@ public:
 	Trigger* midiContinueTrigger;
 
 	FloatParameter* bpm;
+	ParameterPublisher::Slot* bpmSlot; //clock is received on the MIDI thread, bpm is applied by the publisher
 	BoolParameter* sendClock;
 	MIDIClockSender outClock;
 	double lastClockReceiveTime;
@@ -11,17 +11,17 @@
 MQTTClientModule::MQTTClientModule(const String& name, bool canHaveInput, bool canHaveOutput) :
 	Module(name),
 	Thread("MQTT"),
-#if JUCE_WINDOWS
+#if MQTT_SUPPORT
 	mosquittopp("Chataigne"),
 #endif
 	authenticationCC("Authentication"),
-	topicsCC("Topics")
+	lastActivityTime(0)
 {
 
-#if JUCE_WINDOWS
+#if MQTT_SUPPORT
 	mosqpp::lib_init();
 #else
-	NLOGWARNING(niceName, "MQTT is only supported on windows right now.");
+	NLOGWARNING(niceName, "MQTT is not supported on this platform right now.");
 #endif
 
 	protocol = moduleParams.addEnumParameter("Protocol", "How to parse the incoming data");
@@ -41,9 +41,8 @@ MQTTClientModule::MQTTClientModule(const String& name, bool canHaveInput, bool c
 	authenticationCC.enabled->setValue(false);
 	moduleParams.addChildControllableContainer(&authenticationCC);
 
-	topicsCC.userCanAddControllables = true;
-	topicsCC.customUserCreateControllableFunc = std::bind(&MQTTClientModule::topicsCreateCallback, this, std::placeholders::_1);
-	moduleParams.addChildControllableContainer(&topicsCC);
+	moduleParams.addChildControllableContainer(&topicManager);
+	topicManager.addBaseManagerListener(this);
 
 	includeValuesInSave = true;
 	valuesCC.saveAndLoadRecursiveData = true;
@@ -63,7 +62,7 @@ void MQTTClientModule::clearItem()
 {
 	Module::clearItem();
 
-#if JUCE_WINDOWS
+#if MQTT_SUPPORT
 	mosqpp::lib_cleanup();
 #endif
 }
@@ -91,7 +90,7 @@ void MQTTClientModule::onControllableFeedbackUpdateInternal(ControllableContaine
 			if (enabled->boolValue()) startThread();
 		}
 
-		if (c->parentContainer == &topicsCC || c == protocol)
+		if (c->getParentAs<MQTTTopic>() != nullptr || c == protocol)
 		{
 			updateTopicSubs();
 		}
@@ -104,43 +103,32 @@ void MQTTClientModule::onControllableFeedbackUpdateInternal(ControllableContaine
 
 }
 
-void MQTTClientModule::childStructureChanged(ControllableContainer* cc)
+void MQTTClientModule::itemAdded(MQTTTopic* item)
 {
-	Module::childStructureChanged(cc);
-
-	if (!isCurrentlyLoadingData)
-	{
-		if (cc == &moduleParams)
-		{
-			updateTopicSubs();
-		}
-	}
+	if (!isCurrentlyLoadingData) updateTopicSubs();
 }
 
-void MQTTClientModule::topicsCreateCallback(ControllableContainer* cc)
+void MQTTClientModule::itemRemoved(MQTTTopic* item)
 {
-	StringParameter* p = topicsCC.addStringParameter("Topic 1", "Topic to subscribe to", "");
-	p->saveValueOnly = false;
-	p->isRemovableByUser = true;
-	topicsCC.queuedNotifier.addMessage(new ContainerAsyncEvent(ContainerAsyncEvent::ControllableContainerNeedsRebuild, &topicsCC));
+	if (!isCurrentlyLoadingData) updateTopicSubs();
 }
 
-void MQTTClientModule::publishMessage(const String& topic, const String& message)
+void MQTTClientModule::publishMessage(const String& topic, const String& message, int qos, bool retain)
 {
 	if (!enabled->boolValue()) return;
 
-#if JUCE_WINDOWS
+#if MQTT_SUPPORT
 	if (!isConnected->boolValue())
 	{
 		NLOGWARNING(niceName, "Not connected, not sending");
 		return;
 	}
 
-	int result = publish(NULL, topic.toStdString().c_str(), message.length(), message.toStdString().c_str(), 2);
+	int result = publish(NULL, topic.toRawUTF8(), (int)message.getNumBytesAsUTF8(), message.toRawUTF8(), jlimit(0, 2, qos), retain);
 
 	if (logOutgoingData->boolValue())
 	{
-		NLOG(niceName, "Sent topic (" << result << ") : " << topic << ", message : " << message);
+		NLOG(niceName, "Sent topic (" << result << ", QoS " << qos << (retain ? ", retained" : "") << ") : " << topic << ", message : " << message);
 	}
 #endif
 }
@@ -149,34 +137,33 @@ void MQTTClientModule::updateTopicSubs(bool keepData)
 {
 	var oldData(new DynamicObject());
 
-#if JUCE_WINDOWS
-	for (int i = 0; i < topicsCC.controllables.size(); i++)
-	{
-		int mid = topicMap[i];
-		String t = ((StringParameter*)topicsCC.controllables[i])->stringValue();
-		unsubscribe(&mid, t.toStdString().c_str());
+	GenericScopedLock lock(routerLock);
 
-		if (ControllableContainer* cc = valuesCC.getControllableContainerByName(t))
-		{
-			oldData.getDynamicObject()->setProperty(t, cc->getJSONData());
-		}
-	}
+	for (auto& sub : subscriptions)
+	{
+#if MQTT_SUPPORT
+		if (isConnected->boolValue()) unsubscribe(NULL, sub->filter.toRawUTF8());
 #endif
-
+		if (keepData && sub->container != nullptr) oldData.getDynamicObject()->setProperty(sub->filter, sub->container->getJSONData());
+	}
 
 	valuesCC.clear();
-	topicMap.clear();
+	subscriptions.clear();
+	router.clear();
+
+	Protocol p = protocol->getValueDataAsEnum<Protocol>();
 
-	for (auto& c : topicsCC.controllables)
+	for (auto& t : topicManager.items)
 	{
-		String s = ((StringParameter*)c)->stringValue();
+		if (!t->enabled->boolValue()) continue;
+
+		String s = t->topic->stringValue();
 		if (s.isEmpty()) continue;
 
-		Protocol p = protocol->getValueDataAsEnum<Protocol>();
+		Subscription* sub = new Subscription(t);
 
-		switch (p)
-		{
-		case JSON:
+		//wildcard filters always get a container, values for each matching topic are created in it as they arrive
+		if (p == JSON || sub->isWildcard)
 		{
 			ControllableContainer* cc = new ControllableContainer(s);
 			cc->userCanAddControllables = true;
@@ -184,28 +171,105 @@ void MQTTClientModule::updateTopicSubs(bool keepData)
 			cc->saveAndLoadName = true;
 			if (oldData.hasProperty(s)) cc->loadJSONData(oldData.getDynamicObject()->getProperty(s));
 			valuesCC.addChildControllableContainer(cc, true);
+			sub->container = cc;
 		}
-		break;
-
-		case RAW:
+		else
 		{
 			StringParameter* b = valuesCC.addStringParameter(s, "Last received message for this topic", "");
 			b->isSavable = false;
-		}
-		break;
+			sub->parameter = b;
 		}
 
+		router.addFilter(s, subscriptions.size());
+		subscriptions.add(sub);
 
-		int mid = 0;
-#if JUCE_WINDOWS
-		subscribe(&mid, s.toStdString().c_str());
+#if MQTT_SUPPORT
+		if (isConnected->boolValue()) subscribe(NULL, s.toRawUTF8(), sub->qos);
 #endif
-		topicMap.add(mid);
 	}
 
 	valuesCC.queuedNotifier.addMessage(new ContainerAsyncEvent(ContainerAsyncEvent::ControllableContainerNeedsRebuild, &valuesCC));
 }
 
+void MQTTClientModule::routeMessage(Subscription* sub, const String& topic, const String& data, var& jsonData)
+{
+	Protocol p = protocol->getValueDataAsEnum<Protocol>();
+
+	if (p == JSON)
+	{
+		ControllableContainer* cc = sub->container.get();
+		if (cc == nullptr) return;
+
+		if (sub->isWildcard)
+		{
+			ControllableContainer* topicCC = sub->topicContainers[topic].get();
+			if (topicCC == nullptr)
+			{
+				topicCC = cc->getControllableContainerByName(topic, true);
+				if (topicCC == nullptr)
+				{
+					topicCC = new ControllableContainer(topic);
+					topicCC->userCanAddControllables = true;
+					topicCC->saveAndLoadRecursiveData = true;
+					topicCC->saveAndLoadName = true;
+					cc->addChildControllableContainer(topicCC, true);
+				}
+				sub->topicContainers.set(topic, topicCC);
+			}
+			cc = topicCC;
+		}
+
+		if (jsonData.isVoid()) jsonData = JSON::parse(data); //only parsed once when several filters match
+		ControllableParser::createControllablesFromJSONObject(jsonData, cc);
+		return;
+	}
+
+	StringParameter* sp = dynamic_cast<StringParameter*>(sub->parameter.get());
+	if (sub->isWildcard)
+	{
+		sp = dynamic_cast<StringParameter*>(sub->topicParameters[topic].get());
+		if (sp == nullptr && sub->container != nullptr)
+		{
+			sp = dynamic_cast<StringParameter*>(sub->container->getControllableByName(topic, true));
+			if (sp == nullptr)
+			{
+				sp = sub->container->addStringParameter(topic, "Last received message for this topic", "");
+				sp->isSavable = false;
+			}
+			sub->topicParameters.set(topic, sp);
+		}
+	}
+
+	if (sp != nullptr) sp->setValue(data);
+}
+
+var MQTTClientModule::getJSONData()
+{
+	var data = Module::getJSONData();
+	data.getDynamicObject()->setProperty("topics", topicManager.getJSONData());
+	return data;
+}
+
+void MQTTClientModule::loadJSONDataInternal(var data)
+{
+	Module::loadJSONDataInternal(data);
+
+	if (data.hasProperty("topics"))
+	{
+		topicManager.loadJSONData(data.getProperty("topics", var()));
+	}
+	else
+	{
+		//topics used to be plain string parameters in the module parameters
+		var oldTopics = data.getProperty("params", var()).getProperty("containers", var()).getProperty("topics", var()).getProperty("parameters", var());
+		for (int i = 0; i < oldTopics.size(); i++)
+		{
+			String topic = oldTopics[i].getProperty("value", "").toString();
+			if (topic.isNotEmpty()) topicManager.addItem(new MQTTTopic(topic), var(), false);
+		}
+	}
+}
+
 void MQTTClientModule::afterLoadJSONDataInternal()
 {
 	Module::afterLoadJSONDataInternal();
@@ -217,7 +281,7 @@ void MQTTClientModule::run()
 {
 	wait(100);
 
-#if JUCE_WINDOWS
+#if MQTT_SUPPORT
 	if (isConnected->boolValue())
 	{
 		isConnected->setValue(false);
@@ -228,15 +292,15 @@ void MQTTClientModule::run()
 
 	if (authenticationCC.enabled->boolValue())
 	{
-		username_pw_set(username->stringValue().toStdString().c_str(), pass->stringValue().toStdString().c_str());
+		username_pw_set(username->stringValue().toRawUTF8(), pass->stringValue().toRawUTF8());
 		//add tls here
 	}
 	else username_pw_set(NULL);
 
-	int result = connect(host->stringValue().toStdString().c_str(), port->intValue(), keepAlive->intValue());
+	int result = connect(host->stringValue().toRawUTF8(), port->intValue(), keepAlive->intValue());
 
 
-	if (result == 0)
+	if (result == MOSQ_ERR_SUCCESS)
 	{
 		NLOG(niceName, "Connected");
 	}
@@ -247,17 +311,15 @@ void MQTTClientModule::run()
 	}
 
 
-
+	//messages are routed right away from here, nothing is queued in between so a busy broker can't make memory grow
 	while (!threadShouldExit())
 	{
-		int rc = loop();
-		if (rc)
+		int rc = loop(100);
+		if (rc != MOSQ_ERR_SUCCESS)
 		{
 			//LOG("Disconnected, reconnect");
-			reconnect();
-			//LOG("Reconnection : " << rr);
+			if (reconnect() != MOSQ_ERR_SUCCESS) wait(1000);
 		}
-		//wait(2);
 	}
 
 	isConnected->setValue(false);
@@ -265,7 +327,7 @@ void MQTTClientModule::run()
 #endif
 }
 
-#if JUCE_WINDOWS
+#if MQTT_SUPPORT
 void MQTTClientModule::on_connect(int rc)
 {
 	//LOG("MQTT Connected : " << rc);
@@ -275,15 +337,8 @@ void MQTTClientModule::on_connect(int rc)
 	if (rc != 0) return;
 
 	//Subscribe
-	for (int i = 0; i < topicsCC.controllables.size(); i++)
-	{
-		int mid = topicMap[i];
-		String topic = ((StringParameter*)topicsCC.controllables[i])->stringValue();
-		if (topic.isEmpty()) continue;
-		subscribe(&mid, topic.toStdString().c_str());
-		DBG(mid << " <> " << topicMap[i]);
-		topicMap.set(i, mid);
-	}
+	GenericScopedLock lock(routerLock);
+	for (auto& sub : subscriptions) subscribe(NULL, sub->filter.toRawUTF8(), sub->qos);
 }
 
 void MQTTClientModule::on_disconnect(int rc)
@@ -302,8 +357,8 @@ void MQTTClientModule::on_message(const mosquitto_message* message)
 {
 	if (!enabled->boolValue()) return;
 
-	String topic(message->topic);
-	String data((char*)message->payload, message->payloadlen);
+	String topic = String::fromUTF8(message->topic);
+	String data = String::fromUTF8((const char*)message->payload, message->payloadlen);
 	Array<var> args;
 
 	if (logIncomingData->boolValue())
@@ -315,42 +370,32 @@ void MQTTClientModule::on_message(const mosquitto_message* message)
 	args.add(topic);
 	scriptManager->callFunctionOnAllItems(dataEventId, args);
 
-	inActivityTrigger->trigger();
-
-	Protocol p = protocol->getValueDataAsEnum<Protocol>();
-	switch (p)
-	{
-	case JSON:
+	//at telemetry rates, blinking once per frame is enough and keeps the notification queue small
+	double now = Time::getMillisecondCounterHiRes();
+	if (now - lastActivityTime > 20)
 	{
-		if (ControllableContainer* cc = valuesCC.getControllableContainerByName(topic, true))
-		{
-			var jsonData = JSON::parse(data);
-			ControllableParser::createControllablesFromJSONObject(jsonData, cc);
-		}
+		lastActivityTime = now;
+		inActivityTrigger->trigger();
 	}
-	break;
 
-	case RAW:
+	GenericScopedLock lock(routerLock);
+	router.findRoutes(topic, matchedRoutes);
+
+	var jsonData;
+	for (auto& id : matchedRoutes)
 	{
-		if (Parameter* p = valuesCC.getParameterByName(topic, true))
-		{
-			((StringParameter*)p)->setValue(data);
-		}
-	}
-	break;
+		Subscription* sub = subscriptions[id];
+		if (sub == nullptr || (message->retain && sub->ignoreRetained)) continue;
+		routeMessage(sub, topic, data, jsonData);
 	}
 }
 
 void MQTTClientModule::on_subscribe(int mid, int qos_count, const int* granted_qos)
 {
-	//int index = topicMap.indexOf(mid);
-	//if (index >= 0 && topicsCC.controllables.size() > index) NLOG(niceName, "Subscribed to " << ((Parameter*)topicsCC.controllables[index])->stringValue());
 }
 
 void MQTTClientModule::on_unsubscribe(int mid)
 {
-	//int index = topicMap.indexOf(mid);
-	//if (index >= 0 && topicsCC.controllables.size() > index) NLOG(niceName, "Unsubscribed from " << ((Parameter*)topicsCC.controllables[index])->stringValue());
 }
 
 void MQTTClientModule::on_log(int level, const char* str)
@@ -362,4 +407,12 @@ void MQTTClientModule::on_error()
 {
 	NLOGERROR(niceName, "Error !");
 }
-#endif
\ No newline at end of file
+#endif
+
+MQTTClientModule::Subscription::Subscription(MQTTTopic* t) :
+	filter(t->topic->stringValue()),
+	qos(t->getQoS()),
+	ignoreRetained(t->ignoreRetained->boolValue()),
+	isWildcard(MQTTTopicRouter::hasWildcard(filter))
+{
+}
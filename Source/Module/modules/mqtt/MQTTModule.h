@@ -10,16 +10,25 @@
 
 #pragma once
 
-#if JUCE_WINDOWS
+#ifndef MQTT_SUPPORT
+	#if JUCE_WINDOWS || JUCE_LINUX
+		#define MQTT_SUPPORT 1
+	#else
+		#define MQTT_SUPPORT 0
+	#endif
+#endif
+
+#if MQTT_SUPPORT
 #include <mosquittopp.h>
 #endif
 
 class MQTTClientModule :
 	public Module
-#if JUCE_WINDOWS
+#if MQTT_SUPPORT
 	, public mosqpp::mosquittopp
 #endif
 	, public Thread
+	, public MQTTTopicManager::ManagerListener
 {
 public:
 	MQTTClientModule(const String& name = "MQTT Client", bool canHaveInput = true, bool canHaveOutput = true);
@@ -42,8 +51,29 @@ public:
 	StringParameter* username;
 	StringParameter* pass;
 	//BoolParameter* useTLS;
-	Array<int> topicMap;
-	ControllableContainer topicsCC;
+	MQTTTopicManager topicManager;
+
+	//one per enabled topic, wildcard filters get a container holding one value per concrete topic received
+	struct Subscription
+	{
+		Subscription(MQTTTopic* t);
+
+		String filter;
+		int qos;
+		bool ignoreRetained;
+		bool isWildcard;
+
+		WeakReference<ControllableContainer> container;
+		WeakReference<Controllable> parameter;
+		HashMap<String, WeakReference<ControllableContainer>> topicContainers;
+		HashMap<String, WeakReference<Controllable>> topicParameters;
+	};
+
+	OwnedArray<Subscription> subscriptions;
+	MQTTTopicRouter router;
+	CriticalSection routerLock; //subscriptions are rebuilt on the message thread and routed from the MQTT thread
+	Array<int> matchedRoutes; //MQTT thread only
+	double lastActivityTime;
 
 	const Identifier dataEventId = "dataEvent";
 
@@ -51,20 +81,23 @@ public:
 
 	void onContainerParameterChangedInternal(Parameter* p) override;
 	void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
-	void childStructureChanged(ControllableContainer* cc) override;
 
-	void topicsCreateCallback(ControllableContainer* cc);
+	void itemAdded(MQTTTopic* item) override;
+	void itemRemoved(MQTTTopic* item) override;
 
-	void publishMessage(const String& topic, const String& message);
+	void publishMessage(const String& topic, const String& message, int qos = 0, bool retain = false);
 
 	void updateTopicSubs(bool keepData = true);
+	void routeMessage(Subscription* sub, const String& topic, const String& data, var& jsonData);
 
+	var getJSONData() override;
+	void loadJSONDataInternal(var data) override;
 	void afterLoadJSONDataInternal() override;
 
 	void run() override;
 
 	//mosquitto
-#if JUCE_WINDOWS
+#if MQTT_SUPPORT
 	void on_connect(int rc) override;
 	virtual void on_connect_with_flags(int /*rc*/, int /*flags*/) override { return; }
 	virtual void on_disconnect(int rc) override;
@@ -18,6 +18,11 @@ MQTTCommand::MQTTCommand(MQTTClientModule* _module, CommandContext context, var
 	topic = addStringParameter("Topic", "Topic to send to", "");
 	payload = addStringParameter("Payload", "This data to send", "");
 	payload->multiline = true;
+
+	qos = addEnumParameter("QoS", "Quality of service for this message. 0 is fire and forget, 1 and 2 guarantee delivery at the cost of one or two extra round trips with the broker");
+	qos->addOption("0 - At most once", 0)->addOption("1 - At least once", 1)->addOption("2 - Exactly once", 2);
+
+	retain = addBoolParameter("Retain", "If checked, the broker keeps this message and sends it to any client subscribing to this topic later", false);
 }
 
 MQTTCommand::~MQTTCommand()
@@ -27,5 +32,5 @@ MQTTCommand::~MQTTCommand()
 
 void MQTTCommand::triggerInternal(int multiplexIndex)
 {
-	mqttModule->publishMessage(getLinkedValue(topic, multiplexIndex), getLinkedValue(payload, multiplexIndex));
+	mqttModule->publishMessage(getLinkedValue(topic, multiplexIndex), getLinkedValue(payload, multiplexIndex), (int)qos->getValueData(), (bool)getLinkedValue(retain, multiplexIndex));
 }
\ No newline at end of file
@@ -22,6 +22,8 @@ public:
 
 	StringParameter* topic;
 	StringParameter* payload;
+	EnumParameter* qos;
+	BoolParameter* retain;
 
 	void triggerInternal(int multiplexIndex) override;
 
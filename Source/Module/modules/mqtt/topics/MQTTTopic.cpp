@@ -0,0 +1,34 @@
+/*
+  ==============================================================================
+
+	MQTTTopic.cpp
+	Created: 19 Oct 2026 2:08:02am
+	Author:  agent
+
+  ==============================================================================
+*/
+
+MQTTTopic::MQTTTopic(const String& topicFilter) :
+	BaseItem("Topic", true, false)
+{
+	topic = addStringParameter("Topic", "Topic to subscribe to. Use + to match one level and # to match all remaining levels, like sensors/+/temperature or lights/#", topicFilter);
+
+	qos = addEnumParameter("QoS", "Quality of service for this subscription. Higher levels guarantee delivery at the cost of extra round trips with the broker for every message");
+	qos->addOption("0 - At most once", 0)->addOption("1 - At least once", 1)->addOption("2 - Exactly once", 2);
+
+	ignoreRetained = addBoolParameter("Ignore Retained", "If checked, retained messages the broker sends when subscribing are ignored, only live messages are received", false);
+}
+
+MQTTTopic::~MQTTTopic()
+{
+}
+
+MQTTTopicManager::MQTTTopicManager() :
+	BaseManager("Topics")
+{
+	selectItemWhenCreated = false;
+}
+
+MQTTTopicManager::~MQTTTopicManager()
+{
+}
@@ -0,0 +1,33 @@
+/*
+  ==============================================================================
+
+	MQTTTopic.h
+	Created: 19 Oct 2026 2:08:02am
+	Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class MQTTTopic :
+	public BaseItem
+{
+public:
+	MQTTTopic(const String& topicFilter = "");
+	~MQTTTopic();
+
+	StringParameter* topic;
+	EnumParameter* qos;
+	BoolParameter* ignoreRetained;
+
+	int getQoS() const { return (int)qos->getValueData(); }
+};
+
+class MQTTTopicManager :
+	public BaseManager<MQTTTopic>
+{
+public:
+	MQTTTopicManager();
+	~MQTTTopicManager();
+};
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+	MQTTTopicRouter.cpp
+	Created: 19 Oct 2026 2:08:02am
+	Author:  agent
+
+  ==============================================================================
+*/
+
+MQTTTopicRouter::MQTTTopicRouter()
+{
+	clear();
+}
+
+MQTTTopicRouter::~MQTTTopicRouter()
+{
+}
+
+void MQTTTopicRouter::clear()
+{
+	nodes.clear();
+	root = nodes.add(new Node());
+}
+
+void MQTTTopicRouter::addFilter(const String& filter, int routeId)
+{
+	StringArray levels = StringArray::fromTokens(filter, "/", "");
+
+	Node* node = root;
+	for (int i = 0; i < levels.size(); i++)
+	{
+		const String& level = levels[i];
+
+		if (level == "#")
+		{
+			//only valid as the last level, it also matches the parent level itself
+			node->multiLevelRouteIds.addIfNotAlreadyThere(routeId);
+			return;
+		}
+
+		if (level == "+")
+		{
+			if (node->singleLevelChild == nullptr) node->singleLevelChild = nodes.add(new Node());
+			node = node->singleLevelChild;
+			continue;
+		}
+
+		Node* child = node->children[level];
+		if (child == nullptr)
+		{
+			child = nodes.add(new Node());
+			node->children.set(level, child);
+		}
+		node = child;
+	}
+
+	node->routeIds.addIfNotAlreadyThere(routeId);
+}
+
+void MQTTTopicRouter::findRoutes(const String& topic, Array<int>& routeIds) const
+{
+	routeIds.clearQuick();
+	if (topic.isEmpty()) return;
+
+	StringArray levels = StringArray::fromTokens(topic, "/", "");
+	findRoutesInternal(root, levels, 0, routeIds);
+}
+
+void MQTTTopicRouter::findRoutesInternal(const Node* node, const StringArray& levels, int levelIndex, Array<int>& routeIds) const
+{
+	//topics starting with $ are broker internals, wildcards at the first level must not match them
+	bool allowWildcards = levelIndex > 0 || !levels[0].startsWithChar('$');
+
+	if (allowWildcards) for (auto& id : node->multiLevelRouteIds) routeIds.addIfNotAlreadyThere(id);
+
+	if (levelIndex == levels.size())
+	{
+		for (auto& id : node->routeIds) routeIds.addIfNotAlreadyThere(id);
+		return;
+	}
+
+	if (Node* child = node->children[levels[levelIndex]]) findRoutesInternal(child, levels, levelIndex + 1, routeIds);
+	if (allowWildcards && node->singleLevelChild != nullptr) findRoutesInternal(node->singleLevelChild, levels, levelIndex + 1, routeIds);
+}
@@ -0,0 +1,42 @@
+/*
+  ==============================================================================
+
+	MQTTTopicRouter.h
+	Created: 19 Oct 2026 2:08:02am
+	Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//Subscription filters stored as a trie of topic levels, so an incoming topic is matched
+//against every filter, + and # wildcards included, in a single walk of its levels
+class MQTTTopicRouter
+{
+public:
+	MQTTTopicRouter();
+	~MQTTTopicRouter();
+
+	void clear();
+	void addFilter(const String& filter, int routeId);
+	void findRoutes(const String& topic, Array<int>& routeIds) const;
+
+	static bool hasWildcard(const String& filter) { return filter.containsAnyOf("+#"); }
+
+private:
+	struct Node
+	{
+		HashMap<String, Node*> children;
+		Node* singleLevelChild = nullptr; // +
+		Array<int> routeIds; //filters ending on this level
+		Array<int> multiLevelRouteIds; //filters ending with # after this level
+	};
+
+	OwnedArray<Node> nodes;
+	Node* root;
+
+	void findRoutesInternal(const Node* node, const StringArray& levels, int levelIndex, Array<int>& routeIds) const;
+
+	JUCE_DECLARE_NON_COPYABLE(MQTTTopicRouter)
+};
@@ -166,6 +166,14 @@ void OSCModule::processMessage(const OSCMessage& msg)
 
 	if (scriptManager->items.size() > 0)
 	{
+		bool hasOSCEvent = hasScriptCallback(oscEventId);
+		Array<Identifier> matchingCallbacks;
+		for (auto& entry : scriptCallbacks)
+			if (std::get<0>(entry).matches(msg.getAddressPattern().toString()) && hasScriptCallback(std::get<1>(entry)))
+				matchingCallbacks.add(std::get<1>(entry));
+
+		if (!hasOSCEvent && matchingCallbacks.isEmpty()) return;
+
 		Array<var> params;
 		params.add(msg.getAddressPattern().toString());
 		var args = var(Array<var>()); //initialize force array
@@ -184,11 +192,9 @@ void OSCModule::processMessage(const OSCMessage& msg)
 		}
 		params.add(args);
 		params.add(msg.getSenderIPAddress());
-		scriptManager->callFunctionOnAllItems(oscEventId, params);
+		if (hasOSCEvent) scriptManager->callFunctionOnAllItems(oscEventId, params);
 
-		for (auto& entry : scriptCallbacks)
-			if (std::get<0>(entry).matches(msg.getAddressPattern().toString()))
-				scriptManager->callFunctionOnAllItems(std::get<1>(entry), params);
+		for (auto& cb : matchingCallbacks) scriptManager->callFunctionOnAllItems(cb, params);
 	}
 
 }
@@ -648,6 +654,10 @@ OSCOutput::OSCOutput() :
 	remotePort = addIntParameter("Remote port", "Port on which the remote host is listening to", 9000, 1024, 65535);
 	listenToOutputFeedback = addBoolParameter("Listen to Feedback", "If checked, this will listen to the (randomly set) bound port of this sender. This is useful when some softwares automatically detect incoming host and port to send back messages.", false);
 
+	bundleMessages = addBoolParameter("Bundle Messages", "If checked, messages sent within the bundle window are packed into as few OSC bundles as possible. Messages with the same address are merged, only the latest one is sent.", false);
+	bundleWindow = addIntParameter("Bundle Window", "Time in milliseconds to accumulate messages before sending them as bundles", 5, 0, 1000);
+	bundleWindow->setEnabled(bundleMessages->boolValue());
+
 	if (!Engine::mainEngine->isLoadingFile) setupSender();
 }
 
@@ -678,6 +688,10 @@ void OSCOutput::onContainerParameterChangedInternal(Parameter* p)
 	{
 		setupSender();
 	}
+	else if (p == bundleMessages)
+	{
+		bundleWindow->setEnabled(bundleMessages->boolValue());
+	}
 }
 
 InspectableEditor* OSCOutput::getEditorInternal(bool isRoot, Array<Inspectable*> inspectables)
@@ -696,6 +710,8 @@ void OSCOutput::setupSender()
 		const ScopedLock sl(queueLock);
 		while (!messageQueue.empty())
 			messageQueue.pop();
+		frameMessages.clear();
+		frameAddressIndex.clear();
 	}
 
 	senderIsConnected = false;
@@ -738,16 +754,101 @@ void OSCOutput::sendOSC(const OSCMessage& m)
 
 	{
 		const ScopedLock sl(queueLock);
-		messageQueue.push(std::make_unique<OSCMessage>(m));
+		if (bundleMessages->boolValue())
+		{
+			String address = m.getAddressPattern().toString();
+			if (frameAddressIndex.contains(address)) frameMessages.set(frameAddressIndex[address], m);
+			else
+			{
+				frameAddressIndex.set(address, frameMessages.size());
+				frameMessages.add(m);
+			}
+		}
+		else
+		{
+			messageQueue.push(std::make_unique<OSCMessage>(m));
+		}
 	}
 	notify();
 }
 
+void OSCOutput::sendBundles(const Array<OSCMessage>& messages)
+{
+	const int bundleHeaderSize = 16; // "#bundle" + time tag
+
+	Array<const OSCMessage*> batch;
+	int batchSize = bundleHeaderSize;
+
+	auto flush = [this, &batch, &batchSize]()
+	{
+		if (batch.size() == 1) sender.send(*batch[0]);
+		else if (batch.size() > 1)
+		{
+			OSCBundle bundle;
+			for (auto& m : batch) bundle.addElement(*m);
+			sender.send(bundle);
+		}
+
+		batch.clearQuick();
+		batchSize = bundleHeaderSize;
+	};
+
+	for (auto& m : messages)
+	{
+		int elementSize = getMessageSize(m) + 4; //each bundle element is prefixed by its size
+		if (!batch.isEmpty() && batchSize + elementSize > maxDatagramSize) flush();
+		batch.add(&m);
+		batchSize += elementSize;
+	}
+
+	flush();
+}
+
+int OSCOutput::getMessageSize(const OSCMessage& m)
+{
+	auto paddedStringSize = [](int numBytes) { return (numBytes / 4 + 1) * 4; }; //includes null terminator
+
+	int size = paddedStringSize(m.getAddressPattern().toString().getNumBytesAsUTF8());
+	size += paddedStringSize(m.size() + 1); //type tags, with the leading comma
+
+	for (auto& a : m)
+	{
+		if (a.isString()) size += paddedStringSize((int)a.getString().getNumBytesAsUTF8());
+		else if (a.isBlob()) size += 4 + (((int)a.getBlob().getSize() + 3) & ~3);
+		else size += 4;
+	}
+
+	return size;
+}
+
 
 void OSCOutput::run()
 {
 	while (!Engine::mainEngine->isClearing && !threadShouldExit())
 	{
+		bool hasFrame = false;
+		{
+			const ScopedLock sl(queueLock);
+			hasFrame = !frameMessages.isEmpty();
+		}
+
+		if (hasFrame)
+		{
+			//let the frame accumulate, notify() will wake us up on each new message so wait on an absolute deadline
+			const double deadline = Time::getMillisecondCounterHiRes() + bundleWindow->intValue();
+			double remaining = 0;
+			while (!threadShouldExit() && (remaining = deadline - Time::getMillisecondCounterHiRes()) > 0) wait(jmax(1, (int)remaining));
+
+			Array<OSCMessage> messages;
+			{
+				const ScopedLock sl(queueLock);
+				messages.swapWith(frameMessages);
+				frameAddressIndex.clear();
+			}
+
+			sendBundles(messages);
+		}
+
 		std::unique_ptr<OSCMessage> msgToSend;
 
 		{
@@ -761,7 +862,7 @@ void OSCOutput::run()
 
 		if (msgToSend)
 			sender.send(*msgToSend);
-		else
+		else if (!hasFrame)
 			wait(1000); // notify() is called when a message is added to the queue
 	}
 
@@ -769,4 +870,6 @@ void OSCOutput::run()
 	const ScopedLock sl(queueLock);
 	while (!messageQueue.empty())
 		messageQueue.pop();
+	frameMessages.clear();
+	frameAddressIndex.clear();
 }
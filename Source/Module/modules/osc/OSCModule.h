@@ -29,6 +29,12 @@ public:
 	StringParameter * remoteHost;
 	IntParameter * remotePort;
 	BoolParameter* listenToOutputFeedback;
+
+	//Bundling
+	BoolParameter* bundleMessages;
+	IntParameter* bundleWindow;
+	static const int maxDatagramSize = 1472; //Ethernet MTU minus IP and UDP headers
+
 	std::unique_ptr<OSCReceiver> receiver;
 	std::unique_ptr<DatagramSocket> socket;
 
@@ -37,6 +43,9 @@ public:
 	virtual void setupSender();
 	void sendOSC(const OSCMessage & m);
 
+	void sendBundles(const Array<OSCMessage>& messages);
+	static int getMessageSize(const OSCMessage& m);
+
 	virtual void run() override;
 
 	void onContainerParameterChangedInternal(Parameter * p) override;
@@ -47,6 +56,10 @@ private:
 	OSCSender sender;
 	std::queue<std::unique_ptr<OSCMessage>> messageQueue;
 	CriticalSection queueLock;
+
+	//Frame accumulator when bundling, latest message wins for a given address
+	Array<OSCMessage> frameMessages;
+	HashMap<String, int> frameAddressIndex;
 };
 
 class OSCModule :
@@ -200,27 +200,7 @@ void GenericOSCQueryModule::updateTreeFromData(var data)
 
 	isUpdatingStructure = true;
 
-	Array<String> enableListenContainers;
-	Array<String> expandedContainers;
-	Array<WeakReference<ControllableContainer>> containers = valuesCC.getAllContainers(true);
-
-	if (!keepValuesOnSync->boolValue())
-	{
-		for (auto& cc : containers)
-		{
-			if (GenericOSCQueryValueContainer* gcc = dynamic_cast<GenericOSCQueryValueContainer*>(cc.get()))
-			{
-				if (gcc->enableListen->boolValue())
-				{
-					enableListenContainers.add(gcc->getControlAddress(&valuesCC));
-					gcc->enableListen->setValue(false);
-					if (!gcc->editorIsCollapsed) expandedContainers.add(gcc->getControlAddress(&valuesCC));
-				}
-			}
-		}
-	}
-
-
+	//existing containers are kept and only changed nodes are touched, so listen and collapsed states survive the sync as they are
 	var vData(new DynamicObject());
 	if (keepValuesOnSync->boolValue())
 	{
@@ -229,18 +209,9 @@ void GenericOSCQueryModule::updateTreeFromData(var data)
 		{
 			if (p->isOverriden) vData.getDynamicObject()->setProperty(p->getControlAddress(&valuesCC), p->value);
 		}
-
-		for (auto& cc : containers)
-		{
-			if (GenericOSCQueryValueContainer* gcc = dynamic_cast<GenericOSCQueryValueContainer*>(cc.get()))
-			{
-				if (gcc->enableListen->boolValue()) gcc->enableListen->setValue(true, false, true); //force relistening
-			}
-		}
 	}
 
-	//valuesCC.clear();
-
+	addedControllables.clear();
 	updateContainerFromData(&valuesCC, data);
 
 	isUpdatingStructure = false;
@@ -256,25 +227,20 @@ void GenericOSCQueryModule::updateTreeFromData(var data)
 			}
 		}
 	}
-	else
+
+	//new values only have their final address now, and only those need a LISTEN if their container is already listened to
+	Array<WeakReference<Controllable>> newListens;
+	for (auto& c : addedControllables)
 	{
-		for (auto& addr : enableListenContainers)
-		{
-			if (GenericOSCQueryValueContainer* gcc = dynamic_cast<GenericOSCQueryValueContainer*>(valuesCC.getControllableContainerForAddress(addr)))
-			{
-				gcc->enableListen->setValue(true, false, true);
-			}
-		}
+		if (c == nullptr || c.wasObjectDeleted()) continue;
+		indexControllable(c);
 
-		for (auto& addr : expandedContainers)
-		{
-			if (ControllableContainer* cc = valuesCC.getControllableContainerForAddress(addr))
-			{
-				cc->editorIsCollapsed = false;
-				cc->queuedNotifier.addMessage(new ContainerAsyncEvent(ContainerAsyncEvent::ControllableContainerCollapsedChanged, cc)); //should move to a setCollapsed from ControllableContainer.cpp
-			}
-		}
+		GenericOSCQueryValueContainer* gcc = c->getParentAs<GenericOSCQueryValueContainer>();
+		if (gcc != nullptr && gcc->enableListen->boolValue()) newListens.add(c);
 	}
+	addedControllables.clear();
+
+	if (!newListens.isEmpty() && hasListenExtension && wsClient != nullptr && wsClient->isConnected) sendListenCommand(true, newListens);
 
 	treeData = data;
 }
@@ -283,15 +249,19 @@ void GenericOSCQueryModule::updateContainerFromData(ControllableContainer* cc, v
 {
 	DynamicObject* dataObject = data.getProperty("CONTENTS", var()).getDynamicObject();
 
-	Array<WeakReference<ControllableContainer>> containersToDelete = cc->getAllContainers();
-	Array<WeakReference<Controllable>> controllablesToDelete = cc->getAllControllables();
-
 	bool syncContent = true;
-	if (GenericOSCQueryValueContainer* vc = dynamic_cast<GenericOSCQueryValueContainer*>(cc))
+	GenericOSCQueryValueContainer* vc = dynamic_cast<GenericOSCQueryValueContainer*>(cc);
+	if (vc != nullptr) syncContent = vc->syncContent->boolValue();
+
+	//children are matched by their address name, whatever is left unmatched is gone from the server
+	HashMap<String, ControllableContainer*> containersToDelete;
+	HashMap<String, Controllable*> controllablesToDelete;
+
+	for (auto& childCC : cc->controllableContainers) if (childCC != nullptr) containersToDelete.set(childCC->shortName, childCC.get());
+	for (auto& c : cc->controllables)
 	{
-		controllablesToDelete.removeAllInstancesOf(vc->enableListen);
-		controllablesToDelete.removeAllInstancesOf(vc->syncContent);
-		syncContent = vc->syncContent->boolValue();
+		if (vc != nullptr && (c == vc->enableListen || c == vc->syncContent)) continue;
+		controllablesToDelete.set(c->shortName, c);
 	}
 
 	if (syncContent && dataObject != nullptr)
@@ -299,26 +269,28 @@ void GenericOSCQueryModule::updateContainerFromData(ControllableContainer* cc, v
 		NamedValueSet nvSet = dataObject->getProperties();
 		for (auto& nv : nvSet)
 		{
+			String name = nv.name.toString();
+
 			//int access = nv.value.getProperty("ACCESS", 1);
 			bool isGroup = /*access == 0 || */nv.value.hasProperty("CONTENTS");
 			if (isGroup) //group
 			{
 				String ccNiceName;
 				if (!useAddressForNaming->boolValue()) ccNiceName = nv.value.getProperty("DESCRIPTION", "");
-				if (ccNiceName.isEmpty()) ccNiceName = nv.name.toString();
+				if (ccNiceName.isEmpty()) ccNiceName = name;
 
-				GenericOSCQueryValueContainer* childCC = dynamic_cast<GenericOSCQueryValueContainer*>(cc->getControllableContainerByName(ccNiceName, true));
+				GenericOSCQueryValueContainer* childCC = dynamic_cast<GenericOSCQueryValueContainer*>(containersToDelete[name]);
 
 				if (childCC == nullptr)
 				{
 					childCC = new GenericOSCQueryValueContainer(ccNiceName);
 					childCC->saveAndLoadRecursiveData = true;
-					childCC->setCustomShortName(nv.name.toString());
+					childCC->setCustomShortName(name);
 					childCC->editorIsCollapsed = true;
 				}
 				else
 				{
-					containersToDelete.removeAllInstancesOf(childCC);
+					containersToDelete.remove(name);
 					childCC->setNiceName(ccNiceName);
 				}
 
@@ -328,15 +300,28 @@ void GenericOSCQueryModule::updateContainerFromData(ControllableContainer* cc, v
 			}
 			else
 			{
-				Controllable* c = cc->getControllableByName(nv.name.toString());
-				if (c != nullptr) controllablesToDelete.removeAllInstancesOf(c);
-				createOrUpdateControllableFromData(cc, c, nv.name, nv.value);
+				Controllable* c = controllablesToDelete[name];
+				if (c != nullptr) controllablesToDelete.remove(name);
+				createOrUpdateControllableFromData(cc, c, name, nv.value);
 			}
 		}
 	}
 
-	for (auto& cd : controllablesToDelete) cc->removeControllable(cd);
-	for (auto& ccd : containersToDelete) cc->removeChildControllableContainer(ccd);
+	Array<Controllable*> removedControllables;
+	for (HashMap<String, Controllable*>::Iterator it(controllablesToDelete); it.next();) removedControllables.add(it.getValue());
+	for (auto& cd : removedControllables)
+	{
+		unindexControllable(cd);
+		cc->removeControllable(cd);
+	}
+
+	Array<ControllableContainer*> removedContainers;
+	for (HashMap<String, ControllableContainer*>::Iterator it(containersToDelete); it.next();) removedContainers.add(it.getValue());
+	for (auto& ccd : removedContainers)
+	{
+		unindexContainer(ccd);
+		cc->removeChildControllableContainer(ccd);
+	}
 }
 
 void GenericOSCQueryModule::createOrUpdateControllableFromData(ControllableContainer* parentCC, Controllable* sourceC, StringRef name, var data)
@@ -391,6 +376,7 @@ void GenericOSCQueryModule::createOrUpdateControllableFromData(ControllableConta
 
 	if (c != nullptr && targetType != c->type)
 	{
+		unindexControllable(c);
 		parentCC->removeControllable(c);
 		c = nullptr;
 	}
@@ -493,12 +479,53 @@ void GenericOSCQueryModule::createOrUpdateControllableFromData(ControllableConta
 		c->setNiceName(cNiceName);
 		c->setCustomShortName(name);
 		if (access == 1) c->setControllableFeedbackOnly(true);
-		if (addToContainer) parentCC->addControllable(c);
+		if (addToContainer)
+		{
+			parentCC->addControllable(c);
+			addedControllables.add(c);
+		}
 	}
 
 }
 
 
+void GenericOSCQueryModule::indexControllable(Controllable* c)
+{
+	String address = c->getControlAddress(&valuesCC);
+	GenericScopedLock lock(addressMapLock);
+	addressMap.set(address, c);
+}
+
+void GenericOSCQueryModule::unindexControllable(Controllable* c)
+{
+	String address = c->getControlAddress(&valuesCC);
+	GenericScopedLock lock(addressMapLock);
+	addressMap.remove(address);
+}
+
+void GenericOSCQueryModule::unindexContainer(ControllableContainer* cc)
+{
+	Array<WeakReference<Controllable>> controllables = cc->getAllControllables(true);
+	for (auto& c : controllables) if (c != nullptr) unindexControllable(c);
+}
+
+void GenericOSCQueryModule::rebuildAddressMap()
+{
+	Array<WeakReference<Controllable>> controllables = valuesCC.getAllControllables(true);
+
+	GenericScopedLock lock(addressMapLock);
+	addressMap.clear();
+	for (auto& c : controllables)
+	{
+		if (c == nullptr) continue;
+		if (GenericOSCQueryValueContainer* gcc = c->getParentAs<GenericOSCQueryValueContainer>())
+		{
+			if (c == gcc->enableListen || c == gcc->syncContent) continue;
+		}
+		addressMap.set(c->getControlAddress(&valuesCC), c.get());
+	}
+}
+
 void GenericOSCQueryModule::updateAllListens()
 {
 	Array<WeakReference<ControllableContainer>> containers = valuesCC.getAllContainers(true);
@@ -521,20 +548,23 @@ void GenericOSCQueryModule::updateListenToContainer(GenericOSCQueryValueContaine
 	}
 
 	DBG("Add listen for " << gcc->niceName);
-	String command = gcc->enableListen->boolValue() ? "LISTEN" : "IGNORE";
 	Array<WeakReference<Controllable>> params = gcc->getAllControllables();
+	params.removeAllInstancesOf(gcc->enableListen);
+	sendListenCommand(gcc->enableListen->boolValue(), params);
+}
 
+void GenericOSCQueryModule::sendListenCommand(bool listen, const Array<WeakReference<Controllable>>& controllables)
+{
 	var o(new DynamicObject());
-	o.getDynamicObject()->setProperty("COMMAND", command);
+	o.getDynamicObject()->setProperty("COMMAND", listen ? "LISTEN" : "IGNORE");
 
-	for (auto& p : params)
+	for (auto& p : controllables)
 	{
-		if (p == gcc->enableListen) continue;
+		if (p == nullptr) continue;
 		String addr = p->getControlAddress(&valuesCC);
 		o.getDynamicObject()->setProperty("DATA", addr);
 		wsClient->send(JSON::toString(o, true));
 	}
-
 }
 
 
@@ -623,7 +653,15 @@ void GenericOSCQueryModule::dataReceived(const MemoryBlock& data)
 
 	inActivityTrigger->trigger();
 
-	if (Controllable* c = OSCHelpers::findControllable(&valuesCC, m))
+	Controllable* c = nullptr;
+	if (m.getAddressPattern().containsWildcards()) c = OSCHelpers::findControllable(&valuesCC, m);
+	else
+	{
+		GenericScopedLock lock(addressMapLock);
+		c = addressMap[m.getAddressPattern().toString()].get();
+	}
+
+	if (c != nullptr)
 	{
 		noFeedbackList.add(c);
 		OSCHelpers::handleControllableForOSCMessage(c, m);
@@ -656,6 +694,7 @@ void GenericOSCQueryModule::loadJSONDataInternal(var data)
 	updateTreeFromData(data.getProperty("treeData", var()));
 	hasListenExtension = data.getProperty("hasListenExtension", false);
 	Module::loadJSONDataInternal(data);
+	rebuildAddressMap();
 }
 
 void GenericOSCQueryModule::afterLoadJSONDataInternal()
@@ -800,16 +839,19 @@ void GenericOSCQueryModule::requestStructure()
 
 		inActivityTrigger->trigger();
 
+		//parsing stays on this thread, only the diff against the current tree runs on the message thread
 		var data = JSON::parse(content);
 		if (data.isObject())
 		{
 			//if (logIncomingData->boolValue()) NLOG(niceName, "Received structure :\n" << JSON::toString(data));
 
-			updateTreeFromData(data);
-
-			Array<var> args;
-			args.add(data);
-			scriptManager->callFunctionOnAllItems(dataStructureEventId, args);
+			WeakReference<Inspectable> moduleRef(this);
+			MessageManager::callAsync([this, moduleRef, data]()
+				{
+					if (moduleRef.wasObjectDeleted()) return;
+					applyStructure(data);
+				}
+			);
 		}
 	}
 	else
@@ -818,6 +860,17 @@ void GenericOSCQueryModule::requestStructure()
 	}
 }
 
+void GenericOSCQueryModule::applyStructure(var data)
+{
+	if (isCurrentlyLoadingData) return;
+
+	updateTreeFromData(data);
+
+	Array<var> args;
+	args.add(data);
+	scriptManager->callFunctionOnAllItems(dataStructureEventId, args);
+}
+
 void GenericOSCQueryModule::handleRoutedModuleValue(Controllable* c, RouteParams* p)
 {
 	if (!enabled->boolValue()) return;
@@ -73,6 +73,11 @@ public:
 
 	Array<Controllable*> noFeedbackList;
 
+	//OSC address to value, so feedback doesn't walk the tree. Written on the message thread, read from the websocket thread
+	CriticalSection addressMapLock;
+	HashMap<String, WeakReference<Controllable>> addressMap;
+	Array<WeakReference<Controllable>> addedControllables; //during a structure update, indexed once their containers are attached
+
 
 	void setupWSClient();
 
@@ -89,8 +94,14 @@ public:
 	virtual void updateContainerFromData(ControllableContainer* cc, var data);
 	virtual void createOrUpdateControllableFromData(ControllableContainer* parentCC, Controllable* c, StringRef name, var data);
 
+	void indexControllable(Controllable* c);
+	void unindexControllable(Controllable* c);
+	void unindexContainer(ControllableContainer* cc);
+	void rebuildAddressMap();
+
 	void updateAllListens();
 	void updateListenToContainer(GenericOSCQueryValueContainer* gcc);
+	void sendListenCommand(bool listen, const Array<WeakReference<Controllable>>& controllables);
 
 	virtual void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
 
@@ -113,6 +124,7 @@ public:
 	virtual void run() override;
 	virtual void requestHostInfo();
 	virtual void requestStructure();
+	void applyStructure(var data);
 
 	//Routing
 	class OSCQueryRouteParams :
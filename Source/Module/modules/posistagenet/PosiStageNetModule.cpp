@@ -237,7 +237,8 @@ void PosiStageNetModule::run()
 					if (tracker.is_pos_set())
 					{
 						psn::float3 p = tracker.get_pos();
-						s->position->setVector(Vector3D<float>(p.x, p.y, p.z));
+						double pos[3] = { p.x, p.y, p.z };
+						s->positionSlot->publish(pos, 3);
 					}
 
 					//if (tracker.is_speed_set())
@@ -42,10 +42,20 @@ public:
 
 	struct SlotValue
 	{
-		SlotValue(int id, ControllableContainer* container, Point3DParameter* position) : id(id), container(container), position(position) {}
+		SlotValue(int id, ControllableContainer* container, Point3DParameter* position) :
+			id(id), container(container), position(position),
+			positionSlot(ParameterPublisher::getInstance()->addSlot(position))
+		{}
+
+		~SlotValue()
+		{
+			if (ParameterPublisher* publisher = ParameterPublisher::getInstanceWithoutCreating()) publisher->removeSlot(positionSlot);
+		}
+
 		int id;
 		ControllableContainer* container;
 		Point3DParameter* position;
+		ParameterPublisher::Slot* positionSlot; //received positions are applied from the publisher thread, not the network thread
 	};
 
 	OwnedArray<SlotValue> slotValues;
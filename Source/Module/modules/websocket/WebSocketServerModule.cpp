@@ -9,7 +9,8 @@
 */
 
 WebSocketServerModule::WebSocketServerModule(const String& name, int defaultRemotePort) :
-	StreamingModule(name)
+	StreamingModule(name),
+	Thread("WebSocket Server Send")
 {
 	localPort = moduleParams.addIntParameter("Local Port", "Port to bind to listen to incoming data", defaultRemotePort, 1, 65535);
 	useSecureConnection = moduleParams.addBoolParameter("Use Secure Connection", "If checked, you will be able to access this webserver through secure, wss:// connection.", false);
@@ -19,6 +20,8 @@ WebSocketServerModule::WebSocketServerModule(const String& name, int defaultRemo
 	numClients = moduleParams.addIntParameter("Connected Clients", "Number of connected clients", 0);
 	numClients->setControllableFeedbackOnly(true);
 
+	clientQueueLimit = moduleParams.addIntParameter("Client Queue Limit", "Number of messages that can wait for a client before it is considered slow. Past this limit, only the latest message for each address is kept for this client, so slow clients never hold back the others", 256, 1);
+
 	connectionFeedbackRef = isConnected;
 
 	scriptManager->scriptTemplate += ChataigneAssetManager::getInstance()->getScriptTemplate("wsServer");
@@ -28,10 +31,18 @@ WebSocketServerModule::WebSocketServerModule(const String& name, int defaultRemo
 
 WebSocketServerModule::~WebSocketServerModule()
 {
+	stopThread(1000);
 }
 
 void WebSocketServerModule::setupServer()
 {
+	stopThread(1000);
+
+	{
+		GenericScopedLock lock(queuesLock);
+		clientQueues.clear();
+	}
+
 	if (server != nullptr)
 	{
 		server->stop();
@@ -80,6 +91,7 @@ void WebSocketServerModule::setupServer()
 	server->start(localPort->intValue());
 
 	isConnected->setValue(true);
+	startThread();
 
 	NLOG(niceName, "Server is running on port " << localPort->intValue());
 }
@@ -91,61 +103,155 @@ bool WebSocketServerModule::isReadyToSend()
 
 void WebSocketServerModule::sendMessageInternal(const String& message, var params)
 {
+	pushFrame(new OutgoingFrame(message), params);
+}
+
+void WebSocketServerModule::sendBytesInternal(Array<uint8> data, var params)
+{
+	pushFrame(new OutgoingFrame(data), params);
+}
+
+void WebSocketServerModule::pushFrame(OutgoingFrame::Ptr frame, var params)
+{
+	StringArray includes;
+	StringArray excludes;
 	if (params.isObject())
 	{
-		if (params.hasProperty("include"))
-		{
-			var list = params.getProperty("include", var());
-			for (int i = 0; i < list.size(); i++) server->sendTo(message, list[i].toString());
-		}
-		else if (params.hasProperty("exclude"))
+		var includeList = params.getProperty("include", var());
+		for (int i = 0; i < includeList.size(); i++) includes.add(includeList[i].toString());
+		var excludeList = params.getProperty("exclude", var());
+		for (int i = 0; i < excludeList.size(); i++) excludes.add(excludeList[i].toString());
+	}
+
+	bool hasIncludes = params.hasProperty("include");
+	int limit = clientQueueLimit->intValue();
+	frame->isBroadcast = !hasIncludes && excludes.isEmpty();
+
+	{
+		GenericScopedLock lock(queuesLock);
+		for (auto& q : clientQueues)
 		{
-			var list = params.getProperty("exclude", var());
-			StringArray excludes;
-			for (int i = 0; i < list.size(); i++) excludes.add(list[i].toString());
-			server->sendExclude(message, excludes);
+			if (hasIncludes && !includes.contains(q->id)) continue;
+			if (excludes.contains(q->id)) continue;
+			pushFrameToClient(q, frame.get(), limit);
 		}
 	}
-	else
+
+	notify();
+}
+
+void WebSocketServerModule::pushFrameToClient(ClientQueue* q, OutgoingFrame* frame, int limit)
+{
+	if (q->frames.size() >= limit)
 	{
-		server->send(message);
+		//the client is behind, replace the pending value for this address instead of queueing a new one
+		if (frame->address.isNotEmpty() && q->getFrameForAddress(frame->address) != nullptr)
+		{
+			q->frames.set((int)(q->addressIndices[frame->address] - q->numTaken), frame);
+			return;
+		}
+
+		if (q->frames.size() >= limit * 2)
+		{
+			q->numDropped++;
+			return;
+		}
 	}
+
+	if (frame->address.isNotEmpty()) q->addressIndices.set(frame->address, q->numTaken + q->frames.size());
+	q->frames.add(frame);
 }
 
-void WebSocketServerModule::sendBytesInternal(Array<uint8> data, var params)
+void WebSocketServerModule::run()
 {
-	if (params.isObject())
+	while (!threadShouldExit())
 	{
-		MemoryBlock b(data.getRawDataPointer(), data.size());
-		if (params.hasProperty("include"))
+		bool hasPending = false;
+		for (int i = 0; i < maxFramesPerPass && !threadShouldExit(); i++)
 		{
-			var list = params.getProperty("include", var());
-			for (int i = 0; i < list.size(); i++) server->sendTo(b, list[i].toString());
+			hasPending = sendNextFrames();
+			if (!hasPending) break;
 		}
-		else if (params.hasProperty("exclude"))
+
+		if (hasPending) sleep(passInterval);
+		else wait(100);
+	}
+}
+
+bool WebSocketServerModule::sendNextFrames()
+{
+	OutgoingFrame::Ptr sharedFrame;
+	ReferenceCountedArray<OutgoingFrame> framesToSend;
+	StringArray ids;
+	bool hasPending = false;
+
+	{
+		GenericScopedLock lock(queuesLock);
+		if (clientQueues.isEmpty()) return false;
+
+		//a broadcast frame at the head of every queue is encoded once for all clients
+		OutgoingFrame* head = clientQueues[0]->frames.getFirst().get();
+		bool isShared = head != nullptr && head->isBroadcast;
+		for (auto& q : clientQueues) if (q->frames.getFirst().get() != head) isShared = false;
+
+		if (isShared) sharedFrame = head;
+
+		for (auto& q : clientQueues)
 		{
-			var list = params.getProperty("exclude", var());
-			StringArray excludes;
-			for (int i = 0; i < list.size(); i++) excludes.add(list[i].toString());
-			server->sendExclude(b, excludes);
+			if (q->frames.isEmpty()) continue;
+
+			OutgoingFrame::Ptr f = q->takeFirst();
+			if (!isShared)
+			{
+				framesToSend.add(f);
+				ids.add(q->id);
+			}
+
+			if (q->numDropped > 0 && logOutgoingData->boolValue()) NLOGWARNING(niceName, "Client " << q->id << " is too slow, " << q->numDropped << " messages dropped");
+			q->numDropped = 0;
+
+			if (!q->frames.isEmpty()) hasPending = true;
 		}
 	}
-	else
+
+	//sending happens outside the lock so pushing new frames never waits on the server
+	if (sharedFrame != nullptr)
+	{
+		if (sharedFrame->isBinary) server->send((const char*)sharedFrame->data.getData(), (int)sharedFrame->data.getSize());
+		else server->send(sharedFrame->message);
+	}
+
+	for (int i = 0; i < framesToSend.size(); i++)
 	{
-		server->send((const char*)data.getRawDataPointer(), data.size());
+		OutgoingFrame* f = framesToSend.getUnchecked(i);
+		if (f->isBinary) server->sendTo(f->data, ids[i]);
+		else server->sendTo(f->message, ids[i]);
 	}
-	
+
+	return hasPending;
 }
 
 void WebSocketServerModule::connectionOpened(const String& connectionId)
 {
 	NLOG(niceName, "Connection opened from : " << connectionId);
+
+	{
+		GenericScopedLock lock(queuesLock);
+		clientQueues.add(new ClientQueue(connectionId));
+	}
+
 	numClients->setValue(server->getNumActiveConnections());
 }
 
 void WebSocketServerModule::connectionClosed(const String& connectionId, int status, const String& reason)
 {
 	NLOG(niceName, "Connection closed from : " << connectionId);
+
+	{
+		GenericScopedLock lock(queuesLock);
+		for (int i = clientQueues.size() - 1; i >= 0; i--) if (clientQueues[i]->id == connectionId) clientQueues.remove(i);
+	}
+
 	numClients->setValue(server->getNumActiveConnections());
 }
 
@@ -330,3 +436,44 @@ ModuleUI* WebSocketServerModule::getModuleUI()
 {
 	return new WebSocketServerModuleUI(this);
 }
+
+WebSocketServerModule::OutgoingFrame::OutgoingFrame(const String& message) :
+	message(message),
+	isBinary(false),
+	isBroadcast(false)
+{
+	if (!message.startsWithChar('{') && !message.startsWithChar('['))
+	{
+		String a = message.upToFirstOccurrenceOf(" ", false, false).trim();
+		if (a.length() < message.trim().length()) address = a;
+	}
+}
+
+WebSocketServerModule::OutgoingFrame::OutgoingFrame(const Array<uint8>& bytes) :
+	data(bytes.getRawDataPointer(), bytes.size()),
+	isBinary(true),
+	isBroadcast(false)
+{
+}
+
+WebSocketServerModule::OutgoingFrame* WebSocketServerModule::ClientQueue::getFrameForAddress(const String& address)
+{
+	if (!addressIndices.contains(address)) return nullptr;
+	int64 index = addressIndices[address] - numTaken;
+	return isPositiveAndBelow(index, frames.size()) ? frames.getUnchecked((int)index).get() : nullptr;
+}
+
+WebSocketServerModule::OutgoingFrame::Ptr WebSocketServerModule::ClientQueue::takeFirst()
+{
+	OutgoingFrame::Ptr f = frames.getFirst();
+	frames.remove(0);
+	numTaken++;
+
+	if (frames.isEmpty())
+	{
+		addressIndices.clear();
+		numTaken = 0;
+	}
+
+	return f;
+}
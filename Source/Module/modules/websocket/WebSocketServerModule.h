@@ -12,8 +12,8 @@
 
 class WebSocketServerModule :
 	public StreamingModule,
-	public SimpleWebSocketServerBase::Listener
-
+	public SimpleWebSocketServerBase::Listener,
+	public Thread
 {
 public:
 	WebSocketServerModule(const String& name = "WebSocket Server", int defaultRemotePort = 8080);
@@ -24,9 +24,50 @@ public:
 
 	IntParameter* numClients;
 	BoolParameter* isConnected;
+	IntParameter* clientQueueLimit;
 
 	std::unique_ptr<SimpleWebSocketServerBase> server;
 
+	//Outgoing messages are built once and shared by reference between all the client queues they go to
+	class OutgoingFrame :
+		public ReferenceCountedObject
+	{
+	public:
+		OutgoingFrame(const String& message);
+		OutgoingFrame(const Array<uint8>& bytes);
+
+		String message;
+		MemoryBlock data;
+		bool isBinary;
+		bool isBroadcast; //pushed to every client, sent once with server->send while all the queues are in step
+		String address; //leading token of text messages, used to coalesce values for clients that fall behind
+
+		typedef ReferenceCountedObjectPtr<OutgoingFrame> Ptr;
+	};
+
+	struct ClientQueue
+	{
+		ClientQueue(const String& id) : id(id), numDropped(0), numTaken(0) {}
+
+		String id;
+		ReferenceCountedArray<OutgoingFrame> frames;
+		HashMap<String, int64> addressIndices; //latest queued frame for each address, counted from when the queue was last empty
+		int numDropped;
+		int64 numTaken;
+
+		OutgoingFrame* getFrameForAddress(const String& address);
+		OutgoingFrame::Ptr takeFirst();
+	};
+
+	OwnedArray<ClientQueue> clientQueues;
+	CriticalSection queuesLock;
+
+	//the server reports no send completion, so frames are handed over at a bounded rate and the rest waits in the client queues, where the limit applies
+	const int maxFramesPerPass = 8;
+	const int passInterval = 2; //ms
+
+	bool sendNextFrames();
+
 	const Identifier wsMessageReceivedId = "wsMessageReceived";
 	const Identifier wsDataReceivedId = "wsDataReceived";
 
@@ -37,6 +78,9 @@ public:
 	virtual void sendMessageInternal(const String& message, var) override;
 	virtual void sendBytesInternal(Array<uint8> data, var) override;
 
+	void pushFrame(OutgoingFrame::Ptr frame, var params);
+	void pushFrameToClient(ClientQueue* q, OutgoingFrame* frame, int limit);
+
 	void connectionOpened(const String &connectionId) override;
 	void connectionClosed(const String &connectionId, int status, const String &reason) override;
 	void connectionError(const String& connectionId, const String& errorMessage) override;
@@ -52,6 +96,8 @@ public:
 
 	void afterLoadJSONDataInternal() override;
 
+	void run() override;
+
 	ModuleUI* getModuleUI() override;
 
 	static WebSocketServerModule* create() { return new WebSocketServerModule(); }
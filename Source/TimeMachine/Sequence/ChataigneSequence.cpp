@@ -14,7 +14,8 @@ ChataigneSequence::ChataigneSequence() :
 	Sequence(),
 	masterAudioModule(nullptr),
 	masterAudioLayer(nullptr),
-	ltcAudioModule(nullptr)
+	ltcAudioModule(nullptr),
+	freewheelFromMTC(false)
 {
 	midiSyncDevice = new MIDIDeviceParameter("Sync Devices");
 	midiSyncDevice->canBeDisabledByUser = true;
@@ -31,6 +32,20 @@ ChataigneSequence::ChataigneSequence() :
 	reverseOffset = addBoolParameter("Reverse Offset", "This allows negative offset", false);
 	resetTimeOnMTCStopped = addBoolParameter("Reset on MTC Stop", "If checked, sequence will stop and reset time when MTC doesn't send data anymore. If not checked, sequence will just keep its current time", false);
 
+	smoothChase = addBoolParameter("Smooth Chase", "If checked, the sequence phase-locks its own clock on incoming LTC / MTC instead of jumping to each received frame, giving a smooth playhead", true);
+	freewheelTime = addFloatParameter("Freewheel Time", "When LTC / MTC drops out, the sequence keeps playing on its own clock for this time before stopping", 0, 0, 10);
+	freewheelTime->defaultUI = FloatParameter::TIME;
+	chaseLocked = addBoolParameter("Chase Locked", "Is the sequence clock currently locked on incoming timecode ?", false);
+	chaseLocked->setControllableFeedbackOnly(true);
+	chaseOffset = addFloatParameter("Chase Offset", "Last measured difference between incoming timecode and the sequence clock, in milliseconds", 0);
+	chaseOffset->setControllableFeedbackOnly(true);
+
+	timecodeChaser.addChaserListener(this);
+
+	bakeSampleRate = addFloatParameter("Bake Sample Rate", "Number of samples per second when exporting baked values of all mapping layers", 60, 1, 10000);
+	bakeFormat = addEnumParameter("Bake Format", "File format when exporting baked values. CSV has one column per layer value, Binary is a small header followed by interleaved 32-bit floats");
+	bakeFormat->addOption("CSV", SequenceBakeExporter::CSV)->addOption("Binary", SequenceBakeExporter::BINARY);
+	exportBakeTrigger = addTrigger("Export Baked Values", "Evaluate all mapping layers over the whole sequence and write the values to a file");
 
 
 	std::function<bool(ControllableContainer*)> typeCheckFunc = [](ControllableContainer* cc) { return dynamic_cast<AudioModule*>(cc) != nullptr; };
@@ -64,6 +79,9 @@ void ChataigneSequence::clearItem()
 {
 	BaseItem::clearItem();
 
+	timecodeChaser.stopFreewheel();
+	stopBakeExport();
+
 	setMasterAudioLayer(nullptr);
 	setLTCAudioModule(nullptr);
 	Sequence::clearItem();
@@ -238,6 +256,8 @@ void ChataigneSequence::setupMidiSyncDevices()
 
 	//	if ((mtcReceiver != nullptr && midiSyncDevice->inputDevice != mtcReceiver->device) || midiSyncDevice->inputDevice != nullptr)
 	//	{
+	timecodeChaser.reset();
+
 	if (midiSyncDevice->inputDevice == nullptr || !midiSyncDevice->enabled) mtcReceiver.reset();
 	else
 	{
@@ -257,6 +277,7 @@ void ChataigneSequence::setLTCAudioModule(AudioModule* am)
 	}
 
 	ltcAudioModule = am;
+	timecodeChaser.reset();
 
 	if (ltcAudioModule != nullptr)
 	{
@@ -265,6 +286,64 @@ void ChataigneSequence::setLTCAudioModule(AudioModule* am)
 	}
 }
 
+void ChataigneSequence::exportBakedValues(File f)
+{
+	if (bakeExporter != nullptr && bakeExporter->isThreadRunning())
+	{
+		NLOGWARNING(niceName, "A bake export is already running");
+		return;
+	}
+
+	SequenceBakeExporter::Format format = bakeFormat->getValueDataAsEnum<SequenceBakeExporter::Format>();
+
+	if (f == File())
+	{
+		String ext = format == SequenceBakeExporter::CSV ? "*.csv" : "*.bake";
+		FileChooser* fc(new FileChooser("Export baked values", File::getCurrentWorkingDirectory().getChildFile(niceName), ext));
+		fc->launchAsync(FileBrowserComponent::FileChooserFlags::saveMode | FileBrowserComponent::FileChooserFlags::canSelectFiles | FileBrowserComponent::FileChooserFlags::warnAboutOverwriting, [this](const FileChooser& fc)
+			{
+				File f = fc.getResult();
+				delete& fc;
+				if (f == File()) return;
+				exportBakedValues(f);
+			}
+		);
+		return;
+	}
+
+	bakeExporter.reset(new SequenceBakeExporter(this, f, bakeSampleRate->floatValue(), format));
+	bakeExporter->startThread();
+}
+
+void ChataigneSequence::stopBakeExport()
+{
+	bakeExporter.reset();
+}
+
+double ChataigneSequence::getChasedTime(double timecodeTime, bool timecodeIsRunning, double millis)
+{
+	if (smoothChase->boolValue() && timecodeIsRunning)
+	{
+		timecodeTime = timecodeChaser.feed(timecodeTime, millis);
+		chaseOffset->setValue(timecodeChaser.offset * 1000);
+	}
+
+	return timecodeTime + (syncOffset->floatValue() * (reverseOffset->boolValue() ? -1 : 1));
+}
+
+void ChataigneSequence::chaseTimecode(double timecodeTime, bool timecodeIsRunning, bool startIfStopped, double millis)
+{
+	double time = getChasedTime(timecodeTime, timecodeIsRunning, millis);
+	double diff = fabs(currentTime->floatValue() - time);
+	bool isJump = diff > 1;
+	bool seekMode = isJump || !timecodeIsRunning;
+	if (startIfStopped && !isPlaying->boolValue() && time >= 0 && time < totalTime->floatValue()) playTrigger->trigger();
+
+	//chased time is continuous, so it can be applied over the playing clock without stepping
+	bool forceOverPlaying = isJump || (smoothChase->boolValue() && timecodeIsRunning);
+	setCurrentTime(time, forceOverPlaying, seekMode);
+}
+
 void ChataigneSequence::onContainerParameterChangedInternal(Parameter* p)
 {
 	Sequence::onContainerParameterChangedInternal(p);
@@ -273,6 +352,14 @@ void ChataigneSequence::onContainerParameterChangedInternal(Parameter* p)
 	{
 		updateLayersSnapKeys();
 	}
+	else if (p == smoothChase)
+	{
+		timecodeChaser.reset();
+	}
+	else if (p == freewheelTime)
+	{
+		timecodeChaser.freewheelTime = freewheelTime->floatValue();
+	}
 	else if (mtcSender != nullptr && midiSyncDevice->enabled)
 	{
 		float time = jmax<float>(0, currentTime->floatValue() - (syncOffset->floatValue() * (reverseOffset->boolValue() ? -1 : 1)));
@@ -331,6 +418,10 @@ void ChataigneSequence::onContainerTriggerTriggered(Trigger* t)
 	{
 		if (mtcSender != nullptr) mtcSender->stop();
 	}
+	else if (t == exportBakeTrigger)
+	{
+		exportBakedValues();
+	}
 }
 
 void ChataigneSequence::onExternalParameterValueChanged(Parameter* p)
@@ -349,22 +440,20 @@ void ChataigneSequence::onExternalParameterValueChanged(Parameter* p)
 		{
 			if (ltcAudioModule->ltcPlaying->boolValue())
 			{
-				double time = ltcAudioModule->ltcTime->floatValue() + (syncOffset->floatValue() * (reverseOffset->boolValue() ? -1 : 1));
+				timecodeChaser.stopFreewheel();
+				double time = ltcAudioModule->ltcExactTime + (syncOffset->floatValue() * (reverseOffset->boolValue() ? -1 : 1));
 				if (time >= 0 && time < totalTime->floatValue()) playTrigger->trigger();
 			}
 			else
 			{
-				pauseTrigger->trigger();
+				freewheelFromMTC = false;
+				timecodeChaser.startFreewheel();
 			}
 		}
 		else if (p == ltcAudioModule->ltcTime)
 		{
-			double time = ltcAudioModule->ltcTime->floatValue() + (syncOffset->floatValue() * (reverseOffset->boolValue() ? -1 : 1));
-			double diff = fabs(currentTime->floatValue() - time);
-			bool isJump = diff > 1;
-			bool seekMode = isJump || !ltcAudioModule->ltcPlaying->boolValue();
-			if (!isPlaying->boolValue() && time >= 0 && time < totalTime->floatValue()) playTrigger->trigger();
-			setCurrentTime(time, isJump, seekMode);
+			//decode time is used rather than delivery time, so publishing latency doesn't add jitter to the chase
+			chaseTimecode(ltcAudioModule->ltcExactTime, ltcAudioModule->ltcPlaying->boolValue(), true, ltcAudioModule->ltcExactTimeMillis);
 		}
 	}
 }
@@ -377,18 +466,23 @@ void ChataigneSequence::mtcStarted()
 
 void ChataigneSequence::mtcStopped()
 {
-	if (resetTimeOnMTCStopped->boolValue()) stopTrigger->trigger();
-	else pauseTrigger->trigger();
+	freewheelFromMTC = true;
+	timecodeChaser.startFreewheel();
 }
 
 void ChataigneSequence::mtcTimeUpdated(bool isFullFrame)
 {
 	if (mtcReceiver == nullptr) return;
+	chaseTimecode(mtcReceiver->getTime(), mtcReceiver->isPlaying, mtcReceiver->isPlaying);
+}
 
-	double time = mtcReceiver->getTime() + (syncOffset->floatValue() * (reverseOffset->boolValue() ? -1 : 1));
-	double diff = fabs(currentTime->floatValue() - time);
-	bool isJump = diff > 1;
-	bool seekMode = isJump || !mtcReceiver->isPlaying;
-	if (mtcReceiver->isPlaying && !isPlaying->boolValue() && time >= 0 && time < totalTime->floatValue()) playTrigger->trigger();
-	setCurrentTime(time, isJump, seekMode);
+void ChataigneSequence::chaseLockChanged(TimecodeChaser*)
+{
+	chaseLocked->setValue(timecodeChaser.isLocked);
+}
+
+void ChataigneSequence::chaseFreewheelEnded(TimecodeChaser*)
+{
+	if (freewheelFromMTC && resetTimeOnMTCStopped->boolValue()) stopTrigger->trigger();
+	else pauseTrigger->trigger();
 }
@@ -15,12 +15,14 @@ class ChataigneAudioLayer;
 class AudioModule;
 class MTCSender;
 class MIDIDeviceParameter;
+class SequenceBakeExporter;
 
 class ChataigneSequence :
 	public Sequence,
 	public SequenceLayerManager::ManagerListener,
 	public ChataigneAudioLayerListener,
-	public MTCReceiver::MTCListener
+	public MTCReceiver::MTCListener,
+	public TimecodeChaser::ChaserListener
 {
 public:
 	ChataigneSequence();
@@ -40,6 +42,18 @@ public:
 	FloatParameter* syncOffset;
 	BoolParameter* reverseOffset;
 
+	TimecodeChaser timecodeChaser;
+	bool freewheelFromMTC;
+	BoolParameter* smoothChase;
+	FloatParameter* freewheelTime;
+	BoolParameter* chaseLocked;
+	FloatParameter* chaseOffset;
+
+	FloatParameter* bakeSampleRate;
+	EnumParameter* bakeFormat;
+	Trigger* exportBakeTrigger;
+	std::unique_ptr<SequenceBakeExporter> bakeExporter;
+
 	Factory<SequenceLayer> layerFactory;
 
 	virtual void clearItem() override;
@@ -64,6 +78,12 @@ public:
 
 	void setLTCAudioModule(AudioModule* am);
 
+	void exportBakedValues(File f = File());
+	void stopBakeExport();
+
+	double getChasedTime(double timecodeTime, bool timecodeIsRunning, double millis);
+	void chaseTimecode(double timecodeTime, bool timecodeIsRunning, bool startIfStopped, double millis = Time::getMillisecondCounterHiRes());
+
 	virtual void onContainerParameterChangedInternal(Parameter *) override;
 	virtual void onControllableStateChanged(Controllable* c) override;
 
@@ -75,6 +95,9 @@ public:
 	virtual void mtcStopped() override;
 	virtual void mtcTimeUpdated(bool isFullFrame) override;
 
+	virtual void chaseLockChanged(TimecodeChaser*) override;
+	virtual void chaseFreewheelEnded(TimecodeChaser*) override;
+
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChataigneSequence)
 };
 
@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+	SequenceBakeExporter.cpp
+	Created: 19 Oct 2026 1:49:31am
+	Author:  agent
+
+  ==============================================================================
+*/
+
+#include "TimeMachine/TimeMachineIncludes.h"
+
+SequenceBakeExporter::SequenceBakeExporter(ChataigneSequence* sequence, File file, double sampleRate, Format format) :
+	Thread("Sequence Bake Export"),
+	sequence(sequence),
+	file(file),
+	sampleRate(sampleRate),
+	format(format),
+	totalTime(sequence->totalTime->floatValue()),
+	numColumns(0),
+	pool(jmax(1, SystemStats::getNumCpus() - 1))
+{
+	//layer layout and keys are copied here on the message thread, the export thread and the pool only evaluate the copies
+	Array<MappingLayer*> mappingLayers = sequence->layerManager->getItemsWithType<MappingLayer>();
+	for (auto& l : mappingLayers)
+	{
+		std::shared_ptr<MappingSampleSource> source(l->createSampleSource());
+		var v = source->getValueAtPosition(0);
+		int numChannels = v.isArray() ? v.size() : 1;
+		if (numChannels == 0) continue;
+
+		layers.add({ source, l->niceName, numChannels, numColumns });
+		numColumns += numChannels;
+	}
+}
+
+SequenceBakeExporter::~SequenceBakeExporter()
+{
+	stopThread(5000);
+	pool.removeAllJobs(true, 5000);
+}
+
+void SequenceBakeExporter::run()
+{
+	if (layers.isEmpty() || sampleRate <= 0)
+	{
+		NLOGWARNING(sequence->niceName, "Nothing to bake");
+		return;
+	}
+
+	file.deleteFile();
+	std::unique_ptr<FileOutputStream> os(new FileOutputStream(file));
+	if (os->failedToOpen())
+	{
+		NLOGERROR(sequence->niceName, "Could not open " << file.getFullPathName() << " for writing");
+		return;
+	}
+
+	int64 numSamples = (int64)std::floor(totalTime * sampleRate) + 1;
+
+	writeHeader(*os, numSamples);
+
+	Array<float> chunk;
+	WaitableEvent chunkDone;
+	Atomic<int> jobsLeft;
+
+	double startMillis = Time::getMillisecondCounterHiRes();
+
+	for (int64 start = 0; start < numSamples; start += chunkSize)
+	{
+		if (threadShouldExit()) break;
+
+		int count = (int)jmin<int64>(chunkSize, numSamples - start);
+		chunk.resize(count * numColumns);
+		float* data = chunk.getRawDataPointer();
+
+		jobsLeft = layers.size();
+		chunkDone.reset();
+
+		//one job per layer, layers are independent so they can be evaluated concurrently
+		for (auto& lc : layers)
+		{
+			pool.addJob([this, lc, start, count, data, &jobsLeft, &chunkDone]()
+				{
+					for (int i = 0; i < count && !threadShouldExit(); i++)
+					{
+						double t = jmin(totalTime, (start + i) / sampleRate);
+						var v = lc.source->getValueAtPosition((float)t);
+						float* row = data + i * numColumns + lc.offset;
+						if (lc.numChannels == 1) row[0] = (float)v;
+						else for (int c = 0; c < lc.numChannels; c++) row[c] = (float)v[c];
+					}
+
+					if (--jobsLeft == 0) chunkDone.signal();
+				});
+		}
+
+		chunkDone.wait();
+
+		//jobs stop early when cancelled, so this chunk is incomplete
+		if (threadShouldExit()) break;
+		writeChunk(*os, chunk, start, count);
+	}
+
+	os->flush();
+
+	if (threadShouldExit())
+	{
+		//the header announces all the samples, don't leave a truncated file behind
+		os.reset();
+		file.deleteFile();
+		NLOGWARNING(sequence->niceName, "Bake export cancelled");
+		return;
+	}
+
+	NLOG(sequence->niceName, numSamples << " samples of " << layers.size() << " layers baked to " << file.getFullPathName() << " in " << String((Time::getMillisecondCounterHiRes() - startMillis) / 1000.0, 2) << "s");
+}
+
+void SequenceBakeExporter::writeHeader(OutputStream& os, int64 numSamples)
+{
+	if (format == CSV)
+	{
+		os << "index,time";
+		for (auto& lc : layers)
+		{
+			if (lc.numChannels == 1) os << "," << lc.name.replaceCharacter(',', ' ');
+			else for (int c = 0; c < lc.numChannels; c++) os << "," << lc.name.replaceCharacter(',', ' ') << "." << (c + 1);
+		}
+		os << "\n";
+	}
+	else
+	{
+		os.write("CHBK", 4);
+		os.writeInt(1); //version
+		os.writeDouble(sampleRate);
+		os.writeInt64(numSamples);
+		os.writeInt(numColumns);
+		for (auto& lc : layers)
+		{
+			os.writeString(lc.name);
+			os.writeInt(lc.numChannels);
+		}
+	}
+}
+
+void SequenceBakeExporter::writeChunk(OutputStream& os, const Array<float>& chunk, int64 startSample, int numSamples)
+{
+	if (format == BINARY)
+	{
+		os.write(chunk.getRawDataPointer(), sizeof(float) * numSamples * numColumns);
+		return;
+	}
+
+	MemoryOutputStream mos;
+	const float* data = chunk.getRawDataPointer();
+	for (int i = 0; i < numSamples; i++)
+	{
+		mos << String(startSample + i) << "," << String((startSample + i) / sampleRate, 6);
+		for (int c = 0; c < numColumns; c++) mos << "," << String(data[i * numColumns + c]);
+		mos << "\n";
+	}
+
+	os.write(mos.getData(), mos.getDataSize());
+}
@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+	SequenceBakeExporter.h
+	Created: 19 Oct 2026 1:49:31am
+	Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class ChataigneSequence;
+class MappingSampleSource;
+
+//Evaluates all mapping layers of a sequence over its whole length on a worker pool,
+//streaming the result to disk chunk by chunk so hour-long sequences don't need to fit in memory
+class SequenceBakeExporter :
+	public Thread
+{
+public:
+	enum Format { CSV, BINARY };
+
+	SequenceBakeExporter(ChataigneSequence* sequence, File file, double sampleRate, Format format);
+	~SequenceBakeExporter();
+
+	ChataigneSequence* sequence;
+	File file;
+	double sampleRate;
+	Format format;
+	double totalTime;
+
+	struct LayerColumns
+	{
+		std::shared_ptr<MappingSampleSource> source; //keys copied when the export starts, layers can be edited meanwhile
+		String name;
+		int numChannels;
+		int offset; //first column of this layer in a row
+	};
+
+	Array<LayerColumns> layers;
+	int numColumns;
+
+	ThreadPool pool;
+	const int chunkSize = 4096; //samples evaluated per layer and per job
+
+	void run() override;
+
+	void writeHeader(OutputStream& os, int64 numSamples);
+	void writeChunk(OutputStream& os, const Array<float>& chunk, int64 startSample, int numSamples);
+};
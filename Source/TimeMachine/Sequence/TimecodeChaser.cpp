@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+	TimecodeChaser.cpp
+	Created: 19 Oct 2026 1:46:01am
+	Author:  agent
+
+  ==============================================================================
+*/
+
+#include "TimeMachine/TimeMachineIncludes.h"
+
+TimecodeChaser::TimecodeChaser() :
+	isLocked(false),
+	freewheelTime(0)
+{
+	reset();
+}
+
+TimecodeChaser::~TimecodeChaser()
+{
+	stopTimer();
+}
+
+void TimecodeChaser::reset()
+{
+	refTime = 0;
+	refMillis = 0;
+	rate = 1;
+	lastFeedMillis = 0;
+	offset = 0;
+	hasReference = false;
+	numStableFrames = 0;
+	setLocked(false);
+}
+
+double TimecodeChaser::feed(double timecodeTime, double millis)
+{
+	stopFreewheel();
+
+	double predicted = getTimeAt(millis);
+	double error = timecodeTime - predicted;
+	double dt = (millis - lastFeedMillis) / 1000.0;
+
+	if (!hasReference || dt <= 0 || fabs(error) > jumpThreshold)
+	{
+		refTime = timecodeTime;
+		refMillis = millis;
+		lastFeedMillis = millis;
+		rate = 1;
+		offset = 0;
+		hasReference = true;
+		numStableFrames = 0;
+		setLocked(false);
+		return timecodeTime;
+	}
+
+	//second order loop : phase is pulled toward the incoming time, rate integrates the residual error
+	refTime = predicted + error * phaseGain;
+	refMillis = millis;
+	rate = jlimit(1 - maxRateDeviation, 1 + maxRateDeviation, rate + error * rateGain / dt);
+	lastFeedMillis = millis;
+	offset = error;
+
+	if (fabs(error) < lockThreshold) numStableFrames = jmin(numStableFrames + 1, numFramesToLock);
+	else numStableFrames = 0;
+
+	setLocked(numStableFrames >= numFramesToLock);
+
+	return refTime;
+}
+
+double TimecodeChaser::getTimeAt(double millis) const
+{
+	if (!hasReference) return 0;
+	return refTime + (millis - refMillis) / 1000.0 * rate;
+}
+
+void TimecodeChaser::startFreewheel()
+{
+	setLocked(false);
+	numStableFrames = 0;
+
+	if (freewheelTime <= 0) chaserListeners.call(&ChaserListener::chaseFreewheelEnded, this);
+	else startTimer((int)(freewheelTime * 1000));
+}
+
+void TimecodeChaser::stopFreewheel()
+{
+	if (isTimerRunning()) stopTimer();
+}
+
+void TimecodeChaser::timerCallback()
+{
+	stopTimer();
+	hasReference = false;
+	chaserListeners.call(&ChaserListener::chaseFreewheelEnded, this);
+}
+
+void TimecodeChaser::setLocked(bool value)
+{
+	if (isLocked == value) return;
+	isLocked = value;
+	chaserListeners.call(&ChaserListener::chaseLockChanged, this);
+}
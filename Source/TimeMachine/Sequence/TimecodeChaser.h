@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+	TimecodeChaser.h
+	Created: 19 Oct 2026 1:46:01am
+	Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//Phase-locks a local clock onto incoming timecode (LTC / MTC) so a sequence can follow it smoothly
+//instead of jumping by frame-sized steps. Times are in seconds, local clock in Time::getMillisecondCounterHiRes() base.
+class TimecodeChaser :
+	public Timer
+{
+public:
+	TimecodeChaser();
+	~TimecodeChaser();
+
+	double refTime; //chased time at refMillis
+	double refMillis;
+	double rate; //timecode seconds per local second
+	double lastFeedMillis;
+	double offset; //last error between incoming timecode and chased clock, in seconds
+	bool isLocked;
+	bool hasReference;
+	int numStableFrames;
+
+	double freewheelTime; //seconds to keep running on the local clock when timecode drops out
+
+	const double jumpThreshold = 1; //above this error, the chase relocks directly on the incoming time
+	const double lockThreshold = .01; //error under which a frame is considered in phase
+	const int numFramesToLock = 8;
+	const double phaseGain = .1;
+	const double rateGain = .005;
+	const double maxRateDeviation = .1;
+
+	void reset();
+	double feed(double timecodeTime, double millis = Time::getMillisecondCounterHiRes());
+	double getTimeAt(double millis = Time::getMillisecondCounterHiRes()) const;
+
+	void startFreewheel();
+	void stopFreewheel();
+
+	void timerCallback() override;
+
+	class ChaserListener
+	{
+	public:
+		virtual ~ChaserListener() {}
+		virtual void chaseLockChanged(TimecodeChaser*) {}
+		virtual void chaseFreewheelEnded(TimecodeChaser*) {}
+	};
+
+	ListenerList<ChaserListener> chaserListeners;
+	void addChaserListener(ChaserListener* newListener) { chaserListeners.add(newListener); }
+	void removeChaserListener(ChaserListener* listener) { chaserListeners.remove(listener); }
+
+private:
+	void setLocked(bool value);
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TimecodeChaser)
+};
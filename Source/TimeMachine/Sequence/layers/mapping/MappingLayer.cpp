@@ -14,6 +14,7 @@ MappingLayer::MappingLayer(const String &name, Sequence *_sequence, var params)
 	SequenceLayer(_sequence, name),
 	alwaysUpdate(nullptr),
 	sendOnSeek(nullptr),
+	sampleCacheRate(nullptr),
     mappingInputSource(nullptr),
     mappingInput(nullptr)
 {
@@ -29,6 +30,7 @@ MappingLayer::MappingLayer(const String &name, Sequence *_sequence, var params)
 	sendOnPlay = addBoolParameter("Send On Play", " If checked, this will force the value to go through the mapping when sequence starts playing", true);
 	sendOnStop = addBoolParameter("Send On Stop", " If checked, this will force the value to go through the mapping when sequence stops playing", true);
 	sendOnSeek = addBoolParameter("Send On Seek", " If checked, this will force the value to go through the mapping when jumping time", false);
+	sampleCacheRate = addFloatParameter("Cache Resolution", "Number of pre-computed samples per second used during playback instead of evaluating the curves at each frame. Each layer then keeps 4 bytes per value and per sample in memory, 0 disables the cache.", 0, 0, 10000);
 
 	addChildControllableContainer(mapping.get());
 	
@@ -38,6 +40,7 @@ MappingLayer::MappingLayer(const String &name, Sequence *_sequence, var params)
 
 MappingLayer::~MappingLayer()
 {
+	cancelSampleCache();
 }
 
 void MappingLayer::setupMappingInputParameter(Parameter* source)
@@ -88,24 +91,56 @@ void MappingLayer::exportBakedValues(bool dataOnly)
 		values.add(pValues);
 	}
 
-	String s;
+	MemoryOutputStream os;
 	for (int iv = 0; iv < values.size(); iv++)
 	{
-		if(s.isNotEmpty()) s += "\n";
+		if (iv > 0) os << "\n";
 
-		if(!dataOnly) s += String(iv) + "\t" + String(iv * step) + "\t";
+		if(!dataOnly) os << String(iv) << "\t" << String(iv * step) << "\t";
 
-		Array<float> va = values[iv];
+		const Array<float>& va = values.getReference(iv);
 		for (int i = 0; i < va.size(); ++i)
 		{
-			s += (i > 0 ? "," : "") + String(va[i]);
+			if (i > 0) os << ",";
+			os << String(va[i]);
 		}
 	}
 
-	SystemClipboard::copyTextToClipboard(s);
+	SystemClipboard::copyTextToClipboard(os.toString());
 	NLOG(niceName, values.size() << " keys copied to clipboard");
 }
 
+void MappingLayer::invalidateSampleCache()
+{
+	if (sampleCacheRate == nullptr) return;
+
+	if (sampleCacheRate->floatValue() > 0) MappingSampleCacheBaker::getInstance()->requestBake(this);
+	else
+	{
+		cancelSampleCache();
+		sampleCache.invalidate();
+	}
+}
+
+void MappingLayer::cancelSampleCache()
+{
+	if (MappingSampleCacheBaker* baker = MappingSampleCacheBaker::getInstanceWithoutCreating()) baker->cancelBake(this);
+}
+
+bool MappingLayer::canUseSampleCache()
+{
+	return sequence->isPlaying->boolValue() && !sequence->isSeeking;
+}
+
+bool MappingLayer::affectsSampleCache(ControllableContainer* cc, Controllable* c)
+{
+	if (cc == this || c == mappingInputSource || c == mappingInput) return false;
+	for (ControllableContainer* pc = cc; pc != nullptr && pc != this; pc = pc->parentContainer.get())
+	{
+		if (pc == mapping.get()) return false;
+	}
+	return true;
+}
 
 void MappingLayer::onContainerParameterChangedInternal(Parameter * p)
 {
@@ -114,6 +149,10 @@ void MappingLayer::onContainerParameterChangedInternal(Parameter * p)
 	{
 		mapping->setProcessMode(alwaysUpdate->boolValue() ? Mapping::MANUAL : Mapping::VALUE_CHANGE);
 	}
+	else if (p == sampleCacheRate)
+	{
+		invalidateSampleCache();
+	}
 }
 
 void MappingLayer::onContainerTriggerTriggered(Trigger * t)
@@ -125,6 +164,7 @@ void MappingLayer::onControllableFeedbackUpdateInternal(ControllableContainer *
 {
 	SequenceLayer::onControllableFeedbackUpdateInternal(cc, c);
 	if (c == mappingInputSource) updateMappingInputValue();
+	else if (affectsSampleCache(cc, c)) invalidateSampleCache();
 }
 
 void MappingLayer::onExternalParameterRangeChanged(Parameter* p)
@@ -136,6 +176,12 @@ void MappingLayer::onExternalParameterRangeChanged(Parameter* p)
 	}
 }
 
+void MappingLayer::childStructureChanged(ControllableContainer* cc)
+{
+	SequenceLayer::childStructureChanged(cc);
+	if (mappingInputSource != nullptr) invalidateSampleCache();
+}
+
 void MappingLayer::sequenceCurrentTimeChanged(Sequence * s, float prevTime, bool evaluateSkippedData)
 {
 	if (!enabled->boolValue() || !sequence->enabled->boolValue() || alwaysUpdate == nullptr || sendOnSeek == nullptr) return;
@@ -25,23 +25,33 @@ public:
 	BoolParameter* sendOnPlay;
 	BoolParameter* sendOnStop;
 	BoolParameter* sendOnSeek;
+	FloatParameter* sampleCacheRate;
 
 	Parameter* mappingInputSource;
 	Parameter* mappingInput;
 	std::unique_ptr<Mapping> mapping;
 
+	MappingSampleCache sampleCache;
+
 	void setupMappingInputParameter(Parameter* source);
 
 	void updateMappingInputValue(bool forceOutput = false);
 	virtual void updateMappingInputValueInternal();
 
 	virtual var getValueAtPosition(float position) = 0;
+	virtual MappingSampleSource* createSampleSource() = 0; //message thread only
 	void exportBakedValues(bool dataOnly = false);
 
+	void invalidateSampleCache();
+	void cancelSampleCache(); //to call from final class destructors, before the evaluated data gets deleted
+	bool canUseSampleCache();
+	virtual bool affectsSampleCache(ControllableContainer* cc, Controllable* c);
+
 	virtual void onContainerParameterChangedInternal(Parameter* p) override;
 	virtual void onContainerTriggerTriggered(Trigger* t) override;
 	void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
 	void onExternalParameterRangeChanged(Parameter* p) override;
+	void childStructureChanged(ControllableContainer* cc) override;
 
 	void sequenceCurrentTimeChanged(Sequence*, float prevTime, bool evaluateSkippedData) override;
 	virtual void sequenceCurrentTimeChangedInternal(Sequence*, float prevTime, bool evaluateSkippedData) {};
@@ -0,0 +1,218 @@
+/*
+  ==============================================================================
+
+	MappingSampleCache.cpp
+	Created: 19 Oct 2026 1:48:15am
+	Author:  agent
+
+  ==============================================================================
+*/
+
+MappingSampleCache::MappingSampleCache() :
+	numChannels(0),
+	numSamples(0),
+	sampleRate(0),
+	isValid(false)
+{
+}
+
+MappingSampleCache::~MappingSampleCache()
+{
+}
+
+void MappingSampleCache::invalidate()
+{
+	GenericScopedLock lock(this->lock);
+	isValid = false;
+}
+
+void MappingSampleCache::setTable(Array<float>& newSamples, int newNumChannels, double newSampleRate)
+{
+	GenericScopedLock lock(this->lock);
+	samples.swapWith(newSamples);
+	numChannels = newNumChannels;
+	numSamples = numChannels > 0 ? samples.size() / numChannels : 0;
+	sampleRate = newSampleRate;
+	isValid = numSamples > 0;
+}
+
+bool MappingSampleCache::getValueAtPosition(double position, var& result)
+{
+	GenericScopedLock lock(this->lock);
+	if (!isValid) return false;
+
+	double samplePos = jlimit<double>(0, numSamples - 1, position * sampleRate);
+	int index = (int)samplePos;
+	int nextIndex = jmin(index + 1, numSamples - 1);
+	float alpha = (float)(samplePos - index);
+
+	const float* s1 = samples.getRawDataPointer() + index * numChannels;
+	const float* s2 = samples.getRawDataPointer() + nextIndex * numChannels;
+
+	if (numChannels == 1)
+	{
+		result = jmap(alpha, s1[0], s2[0]);
+		return true;
+	}
+
+	result = var();
+	for (int i = 0; i < numChannels; i++) result.append(jmap(alpha, s1[i], s2[i]));
+	return true;
+}
+
+
+juce_ImplementSingleton(MappingSampleCacheBaker)
+
+MappingSampleCacheBaker::MappingSampleCacheBaker() :
+	Thread("Mapping Cache Baker"),
+	currentLayer(nullptr)
+{
+	startThread();
+}
+
+MappingSampleCacheBaker::~MappingSampleCacheBaker()
+{
+	stopTimer();
+	abortCurrent = true;
+	stopThread(1000);
+}
+
+void MappingSampleCacheBaker::requestBake(MappingLayer* layer)
+{
+	{
+		GenericScopedLock lock(queueLock);
+		layer->sampleCache.invalidate();
+		if (currentLayer == layer) abortCurrent = true;
+		pendingLayers.addIfNotAlreadyThere(layer);
+	}
+
+	startTimer(debounceMs); //restarted by each edit, a key drag only bakes once released
+}
+
+void MappingSampleCacheBaker::cancelBake(MappingLayer* layer)
+{
+	Array<BakeJob*> removedJobs;
+	{
+		GenericScopedLock lock(queueLock);
+		pendingLayers.removeAllInstancesOf(layer);
+		for (int i = queue.size() - 1; i >= 0; i--)
+		{
+			if (queue[i]->layer == layer) removedJobs.add(queue.removeAndReturn(i));
+		}
+		if (currentLayer == layer) abortCurrent = true;
+	}
+
+	for (auto& j : removedJobs) deleteJob(j);
+
+	//wait for an ongoing bake of this layer to stop before it gets deleted
+	GenericScopedLock lock(bakeLock);
+}
+
+void MappingSampleCacheBaker::timerCallback()
+{
+	stopTimer();
+
+	Array<BakeJob*> oldJobs;
+	{
+		GenericScopedLock lock(queueLock);
+		for (auto& l : pendingLayers)
+		{
+			//a job still waiting for the thread was copied from outdated keys
+			for (int i = queue.size() - 1; i >= 0; i--)
+			{
+				if (queue[i]->layer == l) oldJobs.add(queue.removeAndReturn(i));
+			}
+
+			BakeJob* job = queue.add(new BakeJob());
+			job->layer = l;
+			job->source.reset(l->createSampleSource());
+			job->rate = l->sampleCacheRate->floatValue();
+			job->length = l->sequence->totalTime->floatValue();
+		}
+
+		pendingLayers.clear();
+	}
+
+	for (auto& j : oldJobs) deleteJob(j);
+	notify();
+}
+
+void MappingSampleCacheBaker::run()
+{
+	while (!threadShouldExit())
+	{
+		wait(-1);
+
+		while (!threadShouldExit())
+		{
+			GenericScopedLock bLock(bakeLock);
+
+			BakeJob* job = nullptr;
+			{
+				GenericScopedLock lock(queueLock);
+				if (queue.isEmpty()) break;
+				job = queue.removeAndReturn(0);
+
+				//edited again since the copy, a new job will come after the debounce
+				if (pendingLayers.contains(job->layer))
+				{
+					deleteJob(job);
+					continue;
+				}
+
+				currentLayer = job->layer;
+				abortCurrent = false;
+			}
+
+			bake(job);
+
+			{
+				GenericScopedLock lock(queueLock);
+				currentLayer = nullptr;
+			}
+
+			deleteJob(job);
+		}
+	}
+}
+
+void MappingSampleCacheBaker::bake(BakeJob* job)
+{
+	double rate = job->rate;
+	double length = job->length;
+	if (job->source == nullptr || rate <= 0 || length <= 0) return;
+
+	int numSamples = (int)std::ceil(length * rate) + 1;
+
+	var firstValue = job->source->getValueAtPosition(0);
+	int numChannels = firstValue.isArray() ? firstValue.size() : 1;
+	if (numChannels == 0 || (int64)numSamples * numChannels > maxCacheValues) return;
+
+	Array<float> samples;
+	samples.resize(numSamples * numChannels);
+	float* data = samples.getRawDataPointer();
+
+	for (int i = 0; i < numSamples; i++)
+	{
+		if ((i & 255) == 0 && (abortCurrent.get() || threadShouldExit())) return;
+
+		var v = i == 0 ? firstValue : job->source->getValueAtPosition((float)jmin(length, i / rate));
+		if (numChannels == 1) data[i] = (float)v;
+		else for (int c = 0; c < numChannels; c++) data[i * numChannels + c] = (float)v[c];
+	}
+
+	GenericScopedLock lock(queueLock); //an invalidation can't slip in between the check and the swap
+	if (abortCurrent.get()) return;
+	job->layer->sampleCache.setTable(samples, numChannels, rate);
+}
+
+void MappingSampleCacheBaker::deleteJob(BakeJob* job)
+{
+	//the copied keys are containers like the layer ones, they are deleted on the message thread
+	MappingSampleSource* source = job->source.release();
+	delete job;
+
+	if (source == nullptr) return;
+	if (MessageManager::existsAndIsCurrentThread()) delete source;
+	else MessageManager::callAsync([source]() { delete source; });
+}
@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+	MappingSampleCache.h
+	Created: 19 Oct 2026 1:48:15am
+	Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class MappingLayer;
+
+//Pre-baked table of a mapping layer output, so playback is a lookup and a lerp instead of a full curve evaluation
+class MappingSampleCache
+{
+public:
+	MappingSampleCache();
+	~MappingSampleCache();
+
+	Array<float> samples; //interleaved, numChannels values per sample
+	int numChannels;
+	int numSamples;
+	double sampleRate;
+	bool isValid;
+	SpinLock lock;
+
+	void invalidate();
+	void setTable(Array<float>& newSamples, int newNumChannels, double newSampleRate);
+	bool getValueAtPosition(double position, var& result);
+
+	JUCE_DECLARE_NON_COPYABLE(MappingSampleCache)
+};
+
+//Copy of a layer's keys, made on the message thread so it can be evaluated from another thread while the layer is edited
+class MappingSampleSource
+{
+public:
+	virtual ~MappingSampleSource() {}
+	virtual var getValueAtPosition(float position) = 0;
+};
+
+//Rebuilds invalidated layer caches on a single background thread.
+//Requests are debounced on the message thread, where the keys are copied, the thread only evaluates the copies
+class MappingSampleCacheBaker :
+	public Thread,
+	public Timer
+{
+public:
+	juce_DeclareSingleton(MappingSampleCacheBaker, true);
+
+	MappingSampleCacheBaker();
+	~MappingSampleCacheBaker();
+
+	struct BakeJob
+	{
+		MappingLayer* layer;
+		std::unique_ptr<MappingSampleSource> source;
+		double rate;
+		double length;
+	};
+
+	Array<MappingLayer*> pendingLayers; //invalidated, waiting for edits to settle
+	OwnedArray<BakeJob> queue;
+	CriticalSection queueLock;
+	CriticalSection bakeLock; //held while a layer is being baked
+	MappingLayer* currentLayer;
+	Atomic<bool> abortCurrent;
+
+	const int debounceMs = 100; //let key drags settle before baking
+	const int maxCacheValues = 1 << 24;
+
+	void requestBake(MappingLayer* layer);
+	void cancelBake(MappingLayer* layer);
+
+	void timerCallback() override;
+	void run() override;
+	void bake(BakeJob* job);
+
+	static void deleteJob(BakeJob* job);
+};
@@ -33,6 +33,7 @@ Mapping1DLayer::Mapping1DLayer(Sequence* s, var params) :
 
 Mapping1DLayer::~Mapping1DLayer()
 {
+    cancelSampleCache();
 }
 
 var Mapping1DLayer::getValueAtPosition(float position)
@@ -40,6 +41,11 @@ var Mapping1DLayer::getValueAtPosition(float position)
     return automation1D.getValueAtPosition(position);
 }
 
+MappingSampleSource* Mapping1DLayer::createSampleSource()
+{
+    return new SampleSource(this);
+}
+
 void Mapping1DLayer::stopRecorderAndAddKeys()
 {
     Array<AutomationRecorder::RecordValue> recordedValues = recorder.stopRecordingAndGetKeys();
@@ -56,3 +62,9 @@ SequenceLayerPanel* Mapping1DLayer::getPanel()
 {
     return new Mapping1DLayerPanel(this);
 }
+
+Mapping1DLayer::SampleSource::SampleSource(Mapping1DLayer* layer)
+{
+    automation.setLength(layer->automation1D.length->floatValue(), true);
+    automation.loadJSONData(layer->automation1D.getJSONData());
+}
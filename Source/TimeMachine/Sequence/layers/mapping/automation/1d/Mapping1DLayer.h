@@ -20,6 +20,7 @@ public:
     Automation automation1D;
 
     virtual var getValueAtPosition(float position) override;
+    virtual MappingSampleSource* createSampleSource() override;
 
     virtual void stopRecorderAndAddKeys() override;
 
@@ -30,4 +31,12 @@ public:
 
     static Mapping1DLayer* create(Sequence* sequence, var params) { return new Mapping1DLayer(sequence, params); }
 
+    class SampleSource :
+        public MappingSampleSource
+    {
+    public:
+        SampleSource(Mapping1DLayer* layer);
+        Automation automation;
+        var getValueAtPosition(float position) override { return automation.getValueAtPosition(position); }
+    };
 };
\ No newline at end of file
@@ -30,6 +30,7 @@ Mapping2DLayer::Mapping2DLayer(Sequence* s, var params) :
 
 Mapping2DLayer::~Mapping2DLayer()
 {
+	cancelSampleCache();
 }
 
 void Mapping2DLayer::addDefaultContent()
@@ -48,6 +49,17 @@ var Mapping2DLayer::getValueAtPosition(float position)
 	return result;
 }
 
+MappingSampleSource* Mapping2DLayer::createSampleSource()
+{
+	return new SampleSource(this);
+}
+
+bool Mapping2DLayer::affectsSampleCache(ControllableContainer* cc, Controllable* c)
+{
+	if (c == curve.position) return false;
+	return AutomationMappingLayer::affectsSampleCache(cc, c);
+}
+
 void Mapping2DLayer::stopRecorderAndAddKeys()
 {
 
@@ -93,3 +105,19 @@ SequenceLayerTimeline* Mapping2DLayer::getTimelineUI()
 {
 	return new Mapping2DTimeline(this);
 }
+
+Mapping2DLayer::SampleSource::SampleSource(Mapping2DLayer* layer)
+{
+	curve.loadJSONData(layer->curve.getJSONData());
+	automation.setLength(layer->automation->length->floatValue(), true);
+	automation.loadJSONData(layer->automation->getJSONData());
+}
+
+var Mapping2DLayer::SampleSource::getValueAtPosition(float position)
+{
+	Point<float> p = curve.getValueAtNormalizedPosition((float)automation.getNormalizedValueAtPosition(position));
+	var result;
+	result.append(p.x);
+	result.append(p.y);
+	return result;
+}
@@ -22,6 +22,8 @@ public:
 	void addDefaultContent() override;
 
 	virtual var getValueAtPosition(float position) override;
+	virtual MappingSampleSource* createSampleSource() override;
+	virtual bool affectsSampleCache(ControllableContainer* cc, Controllable* c) override;
 
 	virtual void stopRecorderAndAddKeys() override;
 
@@ -33,4 +35,13 @@ public:
 
 	static Mapping2DLayer* create(Sequence* sequence, var params) { return new Mapping2DLayer(sequence, params); }
 
+	class SampleSource :
+		public MappingSampleSource
+	{
+	public:
+		SampleSource(Mapping2DLayer* layer);
+		Curve2D curve;
+		Automation automation;
+		var getValueAtPosition(float position) override;
+	};
 };
\ No newline at end of file
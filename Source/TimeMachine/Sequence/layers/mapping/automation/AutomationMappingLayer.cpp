@@ -61,6 +61,16 @@ void AutomationMappingLayer::updateMappingInputValueInternal()
 
 }
 
+bool AutomationMappingLayer::affectsSampleCache(ControllableContainer* cc, Controllable* c)
+{
+	if (automation == nullptr || c == automation->position || c == automation->value) return false;
+	for (ControllableContainer* pc = cc; pc != nullptr && pc != this; pc = pc->parentContainer.get())
+	{
+		if (pc == &recorder) return false;
+	}
+	return MappingLayer::affectsSampleCache(cc, c);
+}
+
 void AutomationMappingLayer::selectAll(bool addToSelection)
 {
 	deselectThis(automation->items.size() == 0);
@@ -118,7 +128,10 @@ void AutomationMappingLayer::sequenceCurrentTimeChangedInternal(Sequence* s, flo
 	if (automation == nullptr) return;
 
 	float curTime = sequence->currentTime->floatValue();
-	automation->position->setValue(curTime);
+
+	var cachedValue;
+	if (canUseSampleCache() && !recorder.isRecording->boolValue() && sampleCache.getValueAtPosition(curTime, cachedValue)) mappingInputSource->setValue(cachedValue);
+	else automation->position->setValue(curTime);
 
 	if (sequence->isPlaying->boolValue())
 	{
@@ -133,6 +146,7 @@ void AutomationMappingLayer::sequenceCurrentTimeChangedInternal(Sequence* s, flo
 void AutomationMappingLayer::sequenceTotalTimeChanged(Sequence* s)
 {
 	automation->setLength(s->totalTime->floatValue());
+	invalidateSampleCache();
 }
 
 void AutomationMappingLayer::sequencePlayStateChangedInternal(Sequence* s)
@@ -141,9 +155,10 @@ void AutomationMappingLayer::sequencePlayStateChangedInternal(Sequence* s)
 	{
 		if (recorder.shouldRecord()) recorder.startRecording();
 	}
-	else if (recorder.isRecording->boolValue())
+	else
 	{
-		stopRecorderAndAddKeys();
+		if (recorder.isRecording->boolValue()) stopRecorderAndAddKeys();
+		if (automation != nullptr) automation->position->setValue(sequence->currentTime->floatValue()); //resync automation after cached playback
 	}
 }
 
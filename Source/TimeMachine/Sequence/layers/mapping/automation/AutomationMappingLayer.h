@@ -26,6 +26,7 @@ public:
     virtual void setupAutomation(Automation* a);
 
     virtual void updateMappingInputValueInternal() override;
+    virtual bool affectsSampleCache(ControllableContainer* cc, Controllable* c) override;
     virtual void stopRecorderAndAddKeys() {}
 
     void selectAll(bool addToSelection = false) override;
@@ -29,6 +29,7 @@ ColorMappingLayer::ColorMappingLayer(Sequence* s, var params) :
 
 ColorMappingLayer::~ColorMappingLayer()
 {
+    cancelSampleCache();
 }
 
 void ColorMappingLayer::addDefaultContent()
@@ -47,6 +48,17 @@ var ColorMappingLayer::getValueAtPosition(float position)
     return result;
 }
 
+MappingSampleSource* ColorMappingLayer::createSampleSource()
+{
+    return new SampleSource(this);
+}
+
+bool ColorMappingLayer::affectsSampleCache(ControllableContainer* cc, Controllable* c)
+{
+    if (c == colorManager.position) return false;
+    return MappingLayer::affectsSampleCache(cc, c);
+}
+
 void ColorMappingLayer::selectAll(bool addToSelection)
 {
     deselectThis(colorManager.items.size() == 0);
@@ -103,12 +115,22 @@ void ColorMappingLayer::getSequenceSnapTimesForManager(Array<float>* arrayToFill
 
 void ColorMappingLayer::sequenceCurrentTimeChanged(Sequence* s, float prevTime, bool seeking)
 {
-    colorManager.position->setValue(sequence->currentTime->floatValue());
+    float curTime = sequence->currentTime->floatValue();
+
+    var cachedValue;
+    if (canUseSampleCache() && sampleCache.getValueAtPosition(curTime, cachedValue)) colorManager.currentColor->setValue(cachedValue);
+    else colorManager.position->setValue(curTime);
 }
 
 void ColorMappingLayer::sequenceTotalTimeChanged(Sequence* s)
 {
     colorManager.setLength(sequence->totalTime->floatValue());
+    invalidateSampleCache();
+}
+
+void ColorMappingLayer::sequencePlayStateChangedInternal(Sequence* s)
+{
+    if (!sequence->isPlaying->boolValue()) colorManager.position->setValue(sequence->currentTime->floatValue()); //resync after cached playback
 }
 
 SequenceLayerPanel* ColorMappingLayer::getPanel()
@@ -120,3 +142,21 @@ SequenceLayerTimeline* ColorMappingLayer::getTimelineUI()
 {
     return new ColorMappingLayerTimeline(this);
 }
+
+ColorMappingLayer::SampleSource::SampleSource(ColorMappingLayer* layer) :
+    colorManager(layer->colorManager.length->floatValue(), false, false)
+{
+    colorManager.allowKeysOutside = false;
+    colorManager.loadJSONData(layer->colorManager.getJSONData());
+}
+
+var ColorMappingLayer::SampleSource::getValueAtPosition(float position)
+{
+    Colour c = colorManager.getColorForPosition(position);
+    var result;
+    result.append(c.getFloatRed());
+    result.append(c.getFloatGreen());
+    result.append(c.getFloatBlue());
+    result.append(c.getFloatAlpha());
+    return result;
+}
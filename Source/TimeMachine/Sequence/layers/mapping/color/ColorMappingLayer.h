@@ -22,6 +22,8 @@ public:
     void addDefaultContent() override;
 
     var getValueAtPosition(float position) override;
+    MappingSampleSource* createSampleSource() override;
+    bool affectsSampleCache(ControllableContainer* cc, Controllable* c) override;
     void selectAll(bool addToSelection = false) override;
 
     Array<Inspectable*> selectAllItemsBetweenInternal(float start, float end) override;
@@ -36,6 +38,7 @@ public:
 
     virtual void sequenceCurrentTimeChanged(Sequence* s, float prevTime, bool seeking) override;
     virtual void sequenceTotalTimeChanged(Sequence* s) override;
+    virtual void sequencePlayStateChangedInternal(Sequence* s) override;
 
     SequenceLayerPanel* getPanel() override;
     SequenceLayerTimeline* getTimelineUI() override;
@@ -43,4 +46,13 @@ public:
     virtual String getTypeString() const override { return getTypeStringStatic(); }
     static const String getTypeStringStatic() { return "Color"; }
     static ColorMappingLayer* create(Sequence* sequence, var params) { return new ColorMappingLayer(sequence, params); }
+
+    class SampleSource :
+        public MappingSampleSource
+    {
+    public:
+        SampleSource(ColorMappingLayer* layer);
+        GradientColorManager colorManager;
+        var getValueAtPosition(float position) override;
+    };
 };
@@ -34,3 +34,90 @@ TimeTrigger* ChataigneTriggerManager::createItem()
 {
 	return new ChataigneTimeTrigger();
 }
+
+void ChataigneTriggerManager::addItemInternal(TimeTrigger* t, var data)
+{
+	TimeTriggerManager::addItemInternal(t, data);
+
+	TriggerTimeComparator comparator;
+	sortedTriggers.addSorted(comparator, t);
+}
+
+void ChataigneTriggerManager::removeItemInternal(TimeTrigger* t)
+{
+	TimeTriggerManager::removeItemInternal(t);
+	sortedTriggers.removeFirstMatchingValue(t);
+}
+
+void ChataigneTriggerManager::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c)
+{
+	TimeTriggerManager::onControllableFeedbackUpdateInternal(cc, c);
+
+	TimeTrigger* t = dynamic_cast<TimeTrigger*>(cc);
+	if (t != nullptr && c == t->time && sortedTriggers.contains(t))
+	{
+		sortedTriggers.removeFirstMatchingValue(t);
+		TriggerTimeComparator comparator;
+		sortedTriggers.addSorted(comparator, t);
+	}
+}
+
+int ChataigneTriggerManager::getFirstTriggerIndexAtOrAfter(float time) const
+{
+	int start = 0;
+	int end = sortedTriggers.size();
+	while (start < end)
+	{
+		int mid = (start + end) / 2;
+		if (sortedTriggers.getUnchecked(mid)->time->floatValue() < time) start = mid + 1;
+		else end = mid;
+	}
+	return start;
+}
+
+int ChataigneTriggerManager::getFirstTriggerIndexAfter(float time) const
+{
+	int start = 0;
+	int end = sortedTriggers.size();
+	while (start < end)
+	{
+		int mid = (start + end) / 2;
+		if (sortedTriggers.getUnchecked(mid)->time->floatValue() <= time) start = mid + 1;
+		else end = mid;
+	}
+	return start;
+}
+
+void ChataigneTriggerManager::sequenceCurrentTimeChanged(Sequence* _sequence, float prevTime, bool evaluateSkippedData)
+{
+	if (!layer->enabled->boolValue() || !sequence->enabled->boolValue()) return;
+
+	float curTime = sequence->currentTime->floatValue();
+
+	if (curTime > prevTime)
+	{
+		if ((sequence->isPlaying->boolValue() && !sequence->isSeeking) || evaluateSkippedData)
+		{
+			//copy the crossed range first, consequences may add or remove triggers
+			int startIndex = getFirstTriggerIndexAtOrAfter(prevTime);
+			int endIndex = getFirstTriggerIndexAfter(curTime);
+			if (startIndex >= endIndex) return;
+
+			Array<TimeTrigger*> spanTriggers(sortedTriggers.begin() + startIndex, endIndex - startIndex);
+			for (auto& tt : spanTriggers)
+			{
+				if (!tt->isTriggered->boolValue()) tt->trigger();
+			}
+		}
+	}
+	else if (curTime < prevTime)
+	{
+		//only the triggers between the two times can have been triggered by the playhead
+		int endIndex = getFirstTriggerIndexAfter(prevTime);
+		for (int i = getFirstTriggerIndexAfter(curTime); i < endIndex; i++)
+		{
+			TimeTrigger* tt = sortedTriggers.getUnchecked(i);
+			if (tt->isTriggered->boolValue()) tt->isTriggered->setValue(false);
+		}
+	}
+}
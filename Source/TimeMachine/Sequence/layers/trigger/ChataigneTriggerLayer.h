@@ -19,7 +19,28 @@ public:
 	ChataigneTriggerManager(ChataigneTriggerLayer* layer, Sequence* sequence);
 	~ChataigneTriggerManager();
 
+	Array<TimeTrigger*> sortedTriggers; //by time, so time changes only look at the crossed range
+
+	struct TriggerTimeComparator
+	{
+		static int compareElements(TimeTrigger* a, TimeTrigger* b)
+		{
+			float ta = a->time->floatValue();
+			float tb = b->time->floatValue();
+			return ta < tb ? -1 : (ta > tb ? 1 : 0);
+		}
+	};
+
 	TimeTrigger* createItem() override;
+
+	void addItemInternal(TimeTrigger* t, var data) override;
+	void removeItemInternal(TimeTrigger* t) override;
+	void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
+
+	int getFirstTriggerIndexAtOrAfter(float time) const;
+	int getFirstTriggerIndexAfter(float time) const;
+
+	void sequenceCurrentTimeChanged(Sequence* _sequence, float prevTime, bool evaluateSkippedData) override;
 };
 
 
@@ -17,12 +17,15 @@
 #include "Common/Processor/Action/Condition/ConditionManagerListener.h" //for ChataigneCue
 
 #include "ChataigneSequenceManager.h"
+#include "Sequence/TimecodeChaser.h"
 #include "Sequence/ChataigneSequence.h"
+#include "Sequence/SequenceBakeExporter.h"
 
 #include "Sequence/layers/audio/ChataigneAudioLayer.h"
 #include "Sequence/layers/audio/ui/ChataigneAudioLayerPanel.h"
 #include "Sequence/layers/audio/ui/ChataigneAudioLayerTimeline.h"
 
+#include "Sequence/layers/mapping/MappingSampleCache.h"
 #include "Sequence/layers/mapping/MappingLayer.h"
 
 #include "Sequence/Cue/ChataigneCue.h"
@@ -2,4 +2,4 @@ echo "Installing armhf cross compilation tools"
 sudo apt-get install -q g++
 
 echo "Installing extra lib dependencies"
-sudo apt-get install -q make libfreetype6-dev libx11-dev libxinerama-dev libxrandr-dev libxcursor-dev libxcomposite-dev mesa-common-dev libasound2-dev freeglut3-dev libcurl4-gnutls-dev libasound2-dev libjack-dev libbluetooth-dev libgtk-3-dev libwebkit2gtk-4.0-dev libsdl2-dev  libfuse2 libusb-1.0-0-dev libhidapi-dev
\ No newline at end of file
+sudo apt-get install -q make libfreetype6-dev libx11-dev libxinerama-dev libxrandr-dev libxcursor-dev libxcomposite-dev mesa-common-dev libasound2-dev freeglut3-dev libcurl4-gnutls-dev libasound2-dev libjack-dev libbluetooth-dev libgtk-3-dev libwebkit2gtk-4.0-dev libsdl2-dev  libfuse2 libusb-1.0-0-dev libhidapi-dev libmosquitto-dev libmosquittopp-dev
\ No newline at end of file